@@ -10,6 +10,11 @@
 #ifndef KLEE_BITARRAY_H
 #define KLEE_BITARRAY_H
 
+#include "llvm/Support/MathExtras.h"
+
+#include <cstdint>
+#include <cstring>
+
 namespace klee {
 
   // XXX would be nice not to have
@@ -17,24 +22,118 @@ namespace klee {
   // BitArrays
 class BitArray {
 private:
-  uint32_t *bits;
-  
+  uint64_t *bits;
+
+  static constexpr unsigned WordBits = 64;
+
+  /// Mask selecting bits [lo, hi) of a single word, with 0 <= lo < hi <= 64.
+  static uint64_t mask(unsigned lo, unsigned hi) {
+    uint64_t upper = hi == WordBits ? ~UINT64_C(0) : (UINT64_C(1) << hi) - 1;
+    return upper & (~UINT64_C(0) << lo);
+  }
+
+  /// Calls f(wordIndex, mask) for every word overlapping [begin, end), with
+  /// mask selecting the bits of that word inside the range. Stops early and
+  /// returns false as soon as f returns false.
+  template <typename F> bool forEachWord(unsigned begin, unsigned end, F f) {
+    if (begin >= end)
+      return true;
+    unsigned first = begin / WordBits, last = (end - 1) / WordBits;
+    unsigned lo = begin % WordBits, hi = (end - 1) % WordBits + 1;
+    if (first == last)
+      return f(first, mask(lo, hi));
+    if (!f(first, mask(lo, WordBits)))
+      return false;
+    for (unsigned w = first + 1; w != last; ++w)
+      if (!f(w, ~UINT64_C(0)))
+        return false;
+    return f(last, mask(0, hi));
+  }
+
 protected:
-  static uint32_t length(unsigned size) { return (size+31)/32; }
+  static uint32_t length(unsigned size) { return (size+WordBits-1)/WordBits; }
 
 public:
-  BitArray(unsigned size, bool value = false) : bits(new uint32_t[length(size)]) {
+  BitArray(unsigned size, bool value = false) : bits(new uint64_t[length(size)]) {
     memset(bits, value?0xFF:0, sizeof(*bits)*length(size));
   }
-  BitArray(const BitArray &b, unsigned size) : bits(new uint32_t[length(size)]) {
+  BitArray(const BitArray &b, unsigned size) : bits(new uint64_t[length(size)]) {
     memcpy(bits, b.bits, sizeof(*bits)*length(size));
   }
   ~BitArray() { delete[] bits; }
 
-  bool get(unsigned idx) { return (bool) ((bits[idx/32]>>(idx&0x1F))&1); }
-  void set(unsigned idx) { bits[idx/32] |= 1<<(idx&0x1F); }
-  void unset(unsigned idx) { bits[idx/32] &= ~(1<<(idx&0x1F)); }
+  bool get(unsigned idx) { return (bool) ((bits[idx/WordBits]>>(idx%WordBits))&1); }
+  void set(unsigned idx) { bits[idx/WordBits] |= UINT64_C(1)<<(idx%WordBits); }
+  void unset(unsigned idx) { bits[idx/WordBits] &= ~(UINT64_C(1)<<(idx%WordBits)); }
   void set(unsigned idx, bool value) { if (value) set(idx); else unset(idx); }
+
+  /// Set all bits in [begin, end).
+  void setRange(unsigned begin, unsigned end) {
+    forEachWord(begin, end, [this](unsigned w, uint64_t m) {
+      bits[w] |= m;
+      return true;
+    });
+  }
+
+  /// Clear all bits in [begin, end).
+  void unsetRange(unsigned begin, unsigned end) {
+    forEachWord(begin, end, [this](unsigned w, uint64_t m) {
+      bits[w] &= ~m;
+      return true;
+    });
+  }
+
+  /// Return true if every bit in [begin, end) is set.
+  bool allSet(unsigned begin, unsigned end) {
+    return forEachWord(begin, end, [this](unsigned w, uint64_t m) {
+      return (bits[w] & m) == m;
+    });
+  }
+
+  /// Return true if no bit in [begin, end) is set.
+  bool noneSet(unsigned begin, unsigned end) {
+    return forEachWord(begin, end, [this](unsigned w, uint64_t m) {
+      return (bits[w] & m) == 0;
+    });
+  }
+
+  /// Return the number of set bits in [begin, end).
+  unsigned count(unsigned begin, unsigned end) {
+    unsigned n = 0;
+    forEachWord(begin, end, [this, &n](unsigned w, uint64_t m) {
+      n += llvm::countPopulation(bits[w] & m);
+      return true;
+    });
+    return n;
+  }
+
+  /// Return the index of the first set bit in [begin, end), or end if there
+  /// is none.
+  unsigned findFirstSet(unsigned begin, unsigned end) {
+    unsigned res = end;
+    forEachWord(begin, end, [this, &res](unsigned w, uint64_t m) {
+      if (uint64_t v = bits[w] & m) {
+        res = w * WordBits + llvm::countTrailingZeros(v);
+        return false;
+      }
+      return true;
+    });
+    return res;
+  }
+
+  /// Return the index of the first unset bit in [begin, end), or end if there
+  /// is none.
+  unsigned findFirstUnset(unsigned begin, unsigned end) {
+    unsigned res = end;
+    forEachWord(begin, end, [this, &res](unsigned w, uint64_t m) {
+      if (uint64_t v = ~bits[w] & m) {
+        res = w * WordBits + llvm::countTrailingZeros(v);
+        return false;
+      }
+      return true;
+    });
+    return res;
+  }
 };
 
 } // End klee namespace
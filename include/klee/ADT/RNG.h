@@ -23,6 +23,7 @@ namespace klee {
   private:
     unsigned int mt[N]; /* the array for the state vector  */
     int mti;
+    unsigned int initialSeed;
 
   public:
     RNG();
@@ -30,6 +31,8 @@ namespace klee {
 
     /* set seed value */
     void seed(unsigned int seed);
+    /* get the last seed value */
+    unsigned int getSeed() const { return initialSeed; }
 
     /* generates a random number on [0,0xffffffff]-interval */
     unsigned int getInt32();
@@ -26,6 +26,7 @@ class raw_fd_ostream;
 }
 
 namespace klee {
+class CoverageMap;
 class ExecutionState;
 class Interpreter;
 class TreeStreamWriter;
@@ -83,8 +84,16 @@ public:
     /// symbolic execution on concrete programs.
     unsigned MakeConcreteSymbolic;
 
+    /// Size in bytes of the edge coverage map tracked for every state, 0 if
+    /// edge coverage is not tracked.
+    unsigned CoverageMapSize;
+
+    /// Distinguish edges in the coverage map by their calling context.
+    bool CoverageMapContext;
+
     InterpreterOptions()
-      : MakeConcreteSymbolic(false)
+      : MakeConcreteSymbolic(false), CoverageMapSize(0),
+        CoverageMapContext(false)
     {}
   };
 
@@ -163,6 +172,16 @@ public:
 
   virtual void getCoveredLines(const ExecutionState &state,
                                std::map<const std::string*, std::set<unsigned> > &res) = 0;
+
+  /// Edges covered on the path of the state, or nullptr if edge coverage
+  /// is not tracked
+  virtual const CoverageMap *getEdgeCoverage(const ExecutionState &state) = 0;
+
+  /// Seed for the next run of a --concolic-runs campaign, derived from the
+  /// runs so far
+  /// \return a KTest to be freed with kTest_free by the caller, or nullptr
+  /// once the campaign is over
+  virtual struct KTest *getNextConcolicSeed() = 0;
 };
 
 } // End klee namespace
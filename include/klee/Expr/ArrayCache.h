@@ -27,6 +27,16 @@ struct EquivArrayCmpFn {
   }
 };
 
+/// Hashes constant arrays by their contents rather than their name
+struct ConstantArrayHashFn {
+  std::size_t operator()(const Array *array) const;
+};
+
+/// Compares constant arrays by their contents rather than their name
+struct ConstantArrayCmpFn {
+  bool operator()(const Array *array1, const Array *array2) const;
+};
+
 /// Provides an interface for creating and destroying Array objects.
 class ArrayCache {
 public:
@@ -59,13 +69,45 @@ public:
                            Expr::Width _domain = Expr::Int32,
                            Expr::Width _range = Expr::Int8);
 
+  /// Create a constant array, or return an existing one with the same
+  /// contents, domain and range (whose name may differ from \p _name).
+  ///
+  /// Unlike the arrays returned by CreateArray, these arrays are reference
+  /// counted by the update lists rooted at them and freed once the last one
+  /// is gone, so an UpdateList has to be built right away. Sharing them lets
+  /// identical tables in different objects and states be translated for the
+  /// solver only once.
+  const Array *CreateConstantArray(const std::string &_name,
+                                   const ref<ConstantExpr> *constantValuesBegin,
+                                   const ref<ConstantExpr> *constantValuesEnd,
+                                   Expr::Width _domain = Expr::Int32,
+                                   Expr::Width _range = Expr::Int8);
+
+  /// Number of interned constant arrays currently alive
+  std::size_t getNumConstantArrays() const { return internedArrays.size(); }
+
+  /// Number of arrays currently held by the cache
+  std::size_t getNumArrays() const {
+    return cachedSymbolicArrays.size() + concreteArrays.size() +
+           internedArrays.size();
+  }
+
 private:
+  friend class UpdateList;
+
+  /// Free an interned array no longer referenced by any update list
+  void release(const Array *array);
+
   typedef std::unordered_set<const Array *, klee::ArrayHashFn,
                              klee::EquivArrayCmpFn>
       ArrayHashMap;
   ArrayHashMap cachedSymbolicArrays;
   typedef std::vector<const Array *> ArrayPtrVec;
   ArrayPtrVec concreteArrays;
+  typedef std::unordered_set<const Array *, ConstantArrayHashFn,
+                             ConstantArrayCmpFn>
+      ConstantArraySet;
+  ConstantArraySet internedArrays;
 };
 }
 
@@ -12,6 +12,8 @@
 
 #include "klee/Expr/Expr.h"
 
+#include <memory>
+
 namespace klee {
 
 /// Resembles a set of constraints that can be passed around
@@ -42,6 +44,14 @@ public:
 
 private:
   constraints_ty constraints;
+
+  /// Size of the set right after it was last compacted
+  size_t compactedSize = 0;
+
+  /// What ConstraintManager::compact() knows of the constraints it already
+  /// compacted, shared by copies of the set until one of them compacts
+  struct CompactionIndex;
+  std::shared_ptr<CompactionIndex> compactionIndex;
 };
 
 class ExprVisitor;
@@ -64,6 +74,14 @@ public:
   /// \param constraint
   void addConstraint(const ref<Expr> &constraint);
 
+  /// Remove redundant constraints without changing the set of solutions:
+  /// duplicates, disjunctions implied by another constraint, and range
+  /// constraints on the same expression, which are merged into at most two
+  /// bounds (or a single equality) where the last of them was.  Only the
+  /// constraints added since the last compaction are examined, the order of
+  /// the others is kept.
+  void compact();
+
 private:
   /// Rewrite set of constraints using the visitor
   /// \param visitor constraint rewriter
@@ -64,6 +64,14 @@ The general rules are:
      </ol>
 </li>
 
+<li> Floating point: the operands of the \c F* kinds and the results of
+     \c FAdd, \c FSub, \c FMul, \c FDiv, \c FPConvert, \c SIToFP and
+     \c UIToFP are the IEEE-754 bit patterns of floats or doubles (width 32
+     or 64). There is no separate floating point sort; solvers reinterpret
+     the bit-vectors as needed. Floating point comparisons are never
+     canonicalized into one another since NaN breaks the usual identities.
+</li>
+
 <li> Linear Formulas: 
    <ol type="a">
    <li> For any subtree representing a linear formula, a constant
@@ -135,6 +143,13 @@ public:
     ZExt,
     SExt,
 
+    // Floating point casting
+    FPConvert, ///< Float to float of another width (fpext/fptrunc)
+    FPToSI,
+    FPToUI,
+    SIToFP,
+    UIToFP,
+
     // Bit
     Not,
 
@@ -169,14 +184,29 @@ public:
     Sgt, ///< Not used in canonical form
     Sge, ///< Not used in canonical form
 
-    LastKind=Sge,
+    // Floating point arithmetic (round to nearest, ties to even)
+    FAdd,
+    FSub,
+    FMul,
+    FDiv,
+
+    // Floating point compare (ordered: false if either operand is NaN)
+    FOEq,
+    FOLt,
+    FOLe,
+
+    LastKind=FOLe,
 
     CastKindFirst=ZExt,
     CastKindLast=SExt,
+    FPCastKindFirst=FPConvert,
+    FPCastKindLast=UIToFP,
     BinaryKindFirst=Add,
-    BinaryKindLast=Sge,
+    BinaryKindLast=FOLe,
     CmpKindFirst=Eq,
-    CmpKindLast=Sge
+    CmpKindLast=Sge,
+    FCmpKindFirst=FOEq,
+    FCmpKindLast=FOLe
   };
 
   /// @brief Required by klee::ref-managed objects
@@ -412,6 +442,21 @@ public:
   static bool classof(const CmpExpr *) { return true; }
 };
 
+class FCmpExpr : public BinaryExpr {
+
+protected:
+  FCmpExpr(ref<Expr> l, ref<Expr> r) : BinaryExpr(l,r) {}
+
+public:
+  Width getWidth() const { return Bool; }
+
+  static bool classof(const Expr *E) {
+    Kind k = E->getKind();
+    return Expr::FCmpKindFirst <= k && k <= Expr::FCmpKindLast;
+  }
+  static bool classof(const FCmpExpr *) { return true; }
+};
+
 // Special
 
 class NotOptimizedExpr : public NonConstantExpr {
@@ -506,6 +551,17 @@ public:
 private:
   unsigned hashValue;
 
+  /// Set for constant arrays interned with ArrayCache::CreateConstantArray,
+  /// which are reference counted by the update lists rooted at them
+  bool interned = false;
+
+  /// Number of update lists rooted at an interned array
+  mutable unsigned refCount = 0;
+
+  /// Cache owning an interned array, cleared if the cache is destroyed
+  /// while the array is still referenced
+  mutable ArrayCache *cache = nullptr;
+
   // FIXME: Make =delete when we switch to C++11
   Array(const Array& array);
 
@@ -539,6 +595,7 @@ public:
   unsigned computeHash();
   unsigned hash() const { return hashValue; }
   friend class ArrayCache;
+  friend class UpdateList;
 };
 
 /// Class representing a complete list of updates into an array.
@@ -553,10 +610,10 @@ public:
 
 public:
   UpdateList(const Array *_root, const ref<UpdateNode> &_head);
-  UpdateList(const UpdateList &b) = default;
-  ~UpdateList() = default;
+  UpdateList(const UpdateList &b);
+  ~UpdateList();
 
-  UpdateList &operator=(const UpdateList &b) = default;
+  UpdateList &operator=(const UpdateList &b);
 
   /// size of this update list
   unsigned getSize() const { return head ? head->getSize() : 0; }
@@ -565,6 +622,11 @@ public:
 
   int compare(const UpdateList &b) const;
   unsigned hash() const;
+
+private:
+  /// Maintain the reference count of an interned root
+  static void retain(const Array *array);
+  static void release(const Array *array);
 };
 
 /// Class representing a one byte read from an array. 
@@ -903,6 +965,71 @@ public:                                                          \
 CAST_EXPR_CLASS(SExt)
 CAST_EXPR_CLASS(ZExt)
 
+// Floating point casting. Unlike CastExpr, the result width may be smaller
+// than the source width and the bits are not preserved.
+
+class FPCastExpr : public NonConstantExpr {
+public:
+  ref<Expr> src;
+  Width width;
+
+public:
+  FPCastExpr(const ref<Expr> &e, Width w) : src(e), width(w) {}
+
+  Width getWidth() const { return width; }
+
+  unsigned getNumKids() const { return 1; }
+  ref<Expr> getKid(unsigned i) const { return (i==0) ? src : 0; }
+
+  static bool needsResultType() { return true; }
+
+  int compareContents(const Expr &b) const {
+    const FPCastExpr &eb = static_cast<const FPCastExpr&>(b);
+    if (width != eb.width) return width < eb.width ? -1 : 1;
+    return 0;
+  }
+
+  virtual unsigned computeHash();
+
+  static bool classof(const Expr *E) {
+    Expr::Kind k = E->getKind();
+    return Expr::FPCastKindFirst <= k && k <= Expr::FPCastKindLast;
+  }
+  static bool classof(const FPCastExpr *) { return true; }
+};
+
+#define FP_CAST_EXPR_CLASS(_class_kind)                          \
+class _class_kind ## Expr : public FPCastExpr {                  \
+public:                                                          \
+  static const Kind kind = _class_kind;                          \
+  static const unsigned numKids = 1;                             \
+public:                                                          \
+    _class_kind ## Expr(ref<Expr> e, Width w) : FPCastExpr(e,w) {} \
+    static ref<Expr> alloc(const ref<Expr> &e, Width w) {        \
+      ref<Expr> r(new _class_kind ## Expr(e, w));                \
+      r->computeHash();                                          \
+      return r;                                                  \
+    }                                                            \
+    static ref<Expr> create(const ref<Expr> &e, Width w);        \
+    Kind getKind() const { return _class_kind; }                 \
+    virtual ref<Expr> rebuild(ref<Expr> kids[]) const {          \
+      return create(kids[0], width);                             \
+    }                                                            \
+                                                                 \
+    static bool classof(const Expr *E) {                         \
+      return E->getKind() == Expr::_class_kind;                  \
+    }                                                            \
+    static bool classof(const  _class_kind ## Expr *) {          \
+      return true;                                               \
+    }                                                            \
+};                                                               \
+
+FP_CAST_EXPR_CLASS(FPConvert)
+FP_CAST_EXPR_CLASS(FPToSI)
+FP_CAST_EXPR_CLASS(FPToUI)
+FP_CAST_EXPR_CLASS(SIToFP)
+FP_CAST_EXPR_CLASS(UIToFP)
+
 // Arithmetic/Bit Exprs
 
 #define ARITHMETIC_EXPR_CLASS(_class_kind)                                     \
@@ -951,6 +1078,10 @@ ARITHMETIC_EXPR_CLASS(Xor)
 ARITHMETIC_EXPR_CLASS(Shl)
 ARITHMETIC_EXPR_CLASS(LShr)
 ARITHMETIC_EXPR_CLASS(AShr)
+ARITHMETIC_EXPR_CLASS(FAdd)
+ARITHMETIC_EXPR_CLASS(FSub)
+ARITHMETIC_EXPR_CLASS(FMul)
+ARITHMETIC_EXPR_CLASS(FDiv)
 
 // Comparison Exprs
 
@@ -997,6 +1128,44 @@ COMPARISON_EXPR_CLASS(Sle)
 COMPARISON_EXPR_CLASS(Sgt)
 COMPARISON_EXPR_CLASS(Sge)
 
+// Floating point comparison Exprs
+
+#define FCMP_EXPR_CLASS(_class_kind)                                           \
+  class _class_kind##Expr : public FCmpExpr {                                  \
+  public:                                                                      \
+    static const Kind kind = _class_kind;                                      \
+    static const unsigned numKids = 2;                                         \
+                                                                               \
+  public:                                                                      \
+    _class_kind##Expr(const ref<Expr> &l, const ref<Expr> &r)                  \
+        : FCmpExpr(l, r) {}                                                    \
+    static ref<Expr> alloc(const ref<Expr> &l, const ref<Expr> &r) {           \
+      ref<Expr> res(new _class_kind##Expr(l, r));                              \
+      res->computeHash();                                                      \
+      return res;                                                              \
+    }                                                                          \
+    static ref<Expr> create(const ref<Expr> &l, const ref<Expr> &r);           \
+    Kind getKind() const { return _class_kind; }                               \
+    virtual ref<Expr> rebuild(ref<Expr> kids[]) const {                        \
+      return create(kids[0], kids[1]);                                         \
+    }                                                                          \
+                                                                               \
+    static bool classof(const Expr *E) {                                       \
+      return E->getKind() == Expr::_class_kind;                                \
+    }                                                                          \
+    static bool classof(const _class_kind##Expr *) { return true; }            \
+                                                                               \
+  protected:                                                                   \
+    virtual int compareContents(const Expr &b) const {                         \
+      /* No attributes to compare. */                                          \
+      return 0;                                                                \
+    }                                                                          \
+  };
+
+FCMP_EXPR_CLASS(FOEq)
+FCMP_EXPR_CLASS(FOLt)
+FCMP_EXPR_CLASS(FOLe)
+
 // Terminal Exprs
 
 class ConstantExpr : public Expr {
@@ -1149,6 +1318,26 @@ public:
 
   ref<ConstantExpr> Neg();
   ref<ConstantExpr> Not();
+
+  // Floating point operations interpret the value as an IEEE-754 float or
+  // double, according to its width.
+
+  /// isFloatingPointWidth - Return true if values of the given width can be
+  /// used as floating point operands.
+  static bool isFloatingPointWidth(Width W) { return W == Int32 || W == Int64; }
+
+  ref<ConstantExpr> FAdd(const ref<ConstantExpr> &RHS);
+  ref<ConstantExpr> FSub(const ref<ConstantExpr> &RHS);
+  ref<ConstantExpr> FMul(const ref<ConstantExpr> &RHS);
+  ref<ConstantExpr> FDiv(const ref<ConstantExpr> &RHS);
+  ref<ConstantExpr> FOEq(const ref<ConstantExpr> &RHS);
+  ref<ConstantExpr> FOLt(const ref<ConstantExpr> &RHS);
+  ref<ConstantExpr> FOLe(const ref<ConstantExpr> &RHS);
+  ref<ConstantExpr> FPConvert(Width W);
+  ref<ConstantExpr> FPToSI(Width W);
+  ref<ConstantExpr> FPToUI(Width W);
+  ref<ConstantExpr> SIToFP(Width W);
+  ref<ConstantExpr> UIToFP(Width W);
 };
 
 // Implementations
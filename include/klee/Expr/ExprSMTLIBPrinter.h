@@ -322,6 +322,10 @@ protected:
   void printSelectExpr(const ref<SelectExpr> &e,
                                ExprSMTLIBPrinter::SMTLIB_SORT s);
   void printAShrExpr(const ref<AShrExpr> &e);
+  void printFPExpr(const ref<Expr> &e);
+
+  /// Print a bitvector expression reinterpreted as a floating point value
+  void printAsFloatingPoint(const ref<Expr> &e);
 
   // For the set of operators that take sort "s" arguments
   void printSortArgsExpr(const ref<Expr> &e,
@@ -358,6 +362,10 @@ protected:
   /// Indicates if there were any constant arrays founds during a scan()
   bool haveConstantArray;
 
+  /// Indicates if there were any floating point expressions found during a
+  /// scan(), in which case the floating point variant of the logic is used
+  bool haveFloatingPoint;
+
 private:
   SMTLIBv2Logic logicToUse;
 
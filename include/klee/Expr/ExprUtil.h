@@ -10,8 +10,12 @@
 #ifndef KLEE_EXPRUTIL_H
 #define KLEE_EXPRUTIL_H
 
+#include "klee/Expr/ExprHashMap.h"
 #include "klee/Expr/ExprVisitor.h"
 
+#include <cstdint>
+#include <map>
+#include <set>
 #include <vector>
 
 namespace klee {
@@ -33,6 +37,13 @@ namespace klee {
   void findSymbolicObjects(ref<Expr> e,
                            std::vector<const Array*> &results);
 
+  /// Find the bytes of symbolic arrays the expression reads. A read at a
+  /// symbolic index, or through an update at a symbolic index, may read
+  /// any byte of its array, which then is added whole. Bytes overwritten
+  /// by updates at constant indices are not read from the array.
+  void findReadBytes(ref<Expr> e,
+                     std::map<const Array *, std::set<std::uint64_t>> &result);
+
   /// Return a list of all unique symbolic objects referenced by the
   /// given expression range.
   template<typename InputIterator>
@@ -40,6 +51,48 @@ namespace klee {
                            InputIterator end,
                            std::vector<const Array*> &results);
 
+  /// Size and shape of the DAG of a set of expressions, e.g. of the
+  /// constraint sets of the states. Structurally equal subexpressions are
+  /// counted once. Constants are not counted as nodes, and update lists are
+  /// measured by their length only.
+  class ExprDAGStats {
+  public:
+    struct Shape {
+      /// Longest path from the expression to a leaf, in nodes
+      std::uint64_t depth;
+      /// Number of nodes of the expression when not shared, i.e. of the
+      /// tree it unfolds to
+      double treeSize;
+    };
+
+  private:
+    ExprHashMap<Shape> shapes;
+    ExprHashSet roots;
+    std::uint64_t totalDepth = 0;
+    double totalTreeSize = 0;
+    std::uint64_t maxUpdateListLength = 0;
+    std::map<Expr::Kind, std::uint64_t> kinds;
+
+  public:
+    /// Add the DAG of e and return the shape of e
+    Shape add(const ref<Expr> &e);
+
+    std::uint64_t getNumRoots() const { return roots.size(); }
+    std::uint64_t getNumNodes() const { return shapes.size(); }
+    /// Average depth of the added expressions
+    double getAverageDepth() const;
+    /// Nodes of the added expressions when unfolded to trees per node of
+    /// their DAG, i.e. 1 without any sharing
+    double getSharing() const;
+    std::uint64_t getMaxUpdateListLength() const {
+      return maxUpdateListLength;
+    }
+    /// Number of nodes of each kind
+    const std::map<Expr::Kind, std::uint64_t> &getKinds() const {
+      return kinds;
+    }
+  };
+
   class ConstantArrayFinder : public ExprVisitor {
   protected:
     ExprVisitor::Action visitRead(const ReadExpr &re);
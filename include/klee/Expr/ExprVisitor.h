@@ -55,6 +55,11 @@ namespace klee {
     virtual Action visitExtract(const ExtractExpr&);
     virtual Action visitZExt(const ZExtExpr&);
     virtual Action visitSExt(const SExtExpr&);
+    virtual Action visitFPConvert(const FPConvertExpr&);
+    virtual Action visitFPToSI(const FPToSIExpr&);
+    virtual Action visitFPToUI(const FPToUIExpr&);
+    virtual Action visitSIToFP(const SIToFPExpr&);
+    virtual Action visitUIToFP(const UIToFPExpr&);
     virtual Action visitAdd(const AddExpr&);
     virtual Action visitSub(const SubExpr&);
     virtual Action visitMul(const MulExpr&);
@@ -79,6 +84,13 @@ namespace klee {
     virtual Action visitSle(const SleExpr&);
     virtual Action visitSgt(const SgtExpr&);
     virtual Action visitSge(const SgeExpr&);
+    virtual Action visitFAdd(const FAddExpr&);
+    virtual Action visitFSub(const FSubExpr&);
+    virtual Action visitFMul(const FMulExpr&);
+    virtual Action visitFDiv(const FDivExpr&);
+    virtual Action visitFOEq(const FOEqExpr&);
+    virtual Action visitFOLt(const FOLtExpr&);
+    virtual Action visitFOLe(const FOLeExpr&);
 
   private:
     typedef ExprHashMap< ref<Expr> > visited_ty;
@@ -12,11 +12,16 @@
 
 #include "klee/Expr/Expr.h"
 
+#include <cstdint>
+
 namespace klee {
   class MemoryObject;
 
   struct Cell {
     ref<Expr> value;
+    /// Taint labels of the value with --shadow-taint (see TaintTracker),
+    /// 0 if untainted
+    std::uint32_t taint = 0;
   };
 }
 
@@ -16,6 +16,7 @@
 #include "llvm/Support/DataTypes.h"
 #include "llvm/Support/raw_ostream.h"
 
+#include <cstdint>
 #include <vector>
 
 namespace llvm {
@@ -42,6 +43,11 @@ namespace klee {
     /// Destination register index.
     unsigned dest;
 
+    /// Forks and solver time (in microseconds) at this instruction, checked
+    /// against the --max-static-*-pct limits
+    std::uint64_t forks = 0;
+    std::uint64_t solverTime = 0;
+
   public:
     virtual ~KInstruction();
     std::string getSourceLocation() const;
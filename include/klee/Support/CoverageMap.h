@@ -0,0 +1,68 @@
+//===-- CoverageMap.h -------------------------------------------*- C++ -*-===//
+//
+//                     The KLEE Symbolic Virtual Machine
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// Fixed-size bitmap of covered control flow edges, in the spirit of AFL's
+// shared memory map: every edge is hashed to one bit, so coverage of
+// different runs is merged by OR-ing their maps.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef KLEE_COVERAGEMAP_H
+#define KLEE_COVERAGEMAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace klee {
+
+class CoverageMap {
+  std::vector<std::uint8_t> bits;
+
+public:
+  CoverageMap() = default;
+
+  /// \param size Size of the map in bytes, a power of two
+  explicit CoverageMap(std::size_t size);
+
+  /// Size of the map in bytes
+  std::size_t size() const { return bits.size(); }
+
+  /// Hash an edge between two instructions, identified by their lines in
+  /// assembly.ll, in the given calling context (0 for none)
+  static std::uint32_t hashEdge(std::uint32_t from, std::uint32_t to,
+                                std::uint32_t context);
+
+  void addEdge(std::uint32_t from, std::uint32_t to,
+               std::uint32_t context = 0) {
+    std::uint32_t bit = hashEdge(from, to, context) & (bits.size() * 8 - 1);
+    bits[bit / 8] |= 1u << (bit % 8);
+  }
+
+  bool operator==(const CoverageMap &other) const {
+    return bits == other.bits;
+  }
+
+  /// Number of set bits
+  std::size_t count() const;
+
+  /// OR the other map, of the same size, into this one
+  /// \return the number of bits newly set
+  std::size_t merge(const CoverageMap &other);
+
+  /// Write the map to a binary file ("KCOV", version and size as 32 bit
+  /// little-endian integers, then the bitmap)
+  bool write(const std::string &path, std::string &error) const;
+  bool read(const std::string &path, std::string &error);
+};
+
+} // namespace klee
+
+#endif /* KLEE_COVERAGEMAP_H */
@@ -0,0 +1,89 @@
+//===-- DependencyIndex.h ---------------------------------------*- C++ -*-===//
+//
+//                     The KLEE Symbolic Virtual Machine
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// Index of the symbolic input bytes the condition of each branch site reads,
+// so that a campaign driver can mutate only the bytes relevant to a branch
+// without parsing the path conditions.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef KLEE_DEPENDENCYINDEX_H
+#define KLEE_DEPENDENCYINDEX_H
+
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace klee {
+class DependencyIndexReader;
+
+class DependencyIndex {
+public:
+  /// Consecutive bytes [begin, end) of a symbolic object
+  struct Range {
+    std::uint32_t object;
+    std::uint32_t begin;
+    std::uint32_t end;
+
+    bool operator==(const Range &other) const {
+      return object == other.object && begin == other.begin &&
+             end == other.end;
+    }
+  };
+
+  struct Site {
+    std::string file;
+    std::uint32_t line = 0;
+    /// Bytes read by the branch conditions at the site, by object
+    std::map<std::uint32_t, std::set<std::uint32_t>> bytes;
+
+    /// The bytes as ranges, ordered by object and offset
+    std::vector<Range> getRanges() const;
+  };
+
+private:
+  std::vector<std::string> objects;
+  /// Size in bytes of each object
+  std::vector<std::uint32_t> objectSizes;
+  std::map<std::string, std::uint32_t> objectIndices;
+  /// Branch sites by their line in assembly.ll
+  std::map<std::uint32_t, Site> sites;
+
+  bool readContents(DependencyIndexReader &in, std::string &error);
+
+public:
+  /// Index of the symbolic object with the given name, added if new. Its
+  /// size is raised to at least the given one.
+  std::uint32_t getObject(const std::string &name, std::uint32_t size);
+
+  /// The site of the branch at the given line in assembly.ll, added if new
+  Site &getSite(std::uint32_t assemblyLine, const std::string &file,
+                std::uint32_t line);
+
+  const std::vector<std::string> &getObjects() const { return objects; }
+  const std::vector<std::uint32_t> &getObjectSizes() const {
+    return objectSizes;
+  }
+  const std::map<std::uint32_t, Site> &getSites() const { return sites; }
+
+  /// Write the index to a binary file: "KDEP" and the version, the object
+  /// names and sizes, then for each site its assembly line, source line and
+  /// file, and its byte ranges. Integers are 32 bit little-endian, strings
+  /// are prefixed by their length.
+  bool write(const std::string &path, std::string &error) const;
+  /// Read an index written by write(). Files whose ranges are unordered,
+  /// overlap or exceed their object are rejected.
+  bool read(const std::string &path, std::string &error);
+};
+
+} // namespace klee
+
+#endif /* KLEE_DEPENDENCYINDEX_H */
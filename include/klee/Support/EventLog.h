@@ -0,0 +1,89 @@
+//===-- EventLog.h ----------------------------------------------*- C++ -*-===//
+//
+//                     The KLEE Symbolic Virtual Machine
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// Asynchronous log for the concolic events (partial path conditions, traces,
+// concretizations, ...). Every thread appends typed records to its own
+// lock-free ring buffer and a background thread drains them in batches into
+// the registered sinks, so that logging costs no system call on the
+// interpreter thread.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef KLEE_EVENTLOG_H
+#define KLEE_EVENTLOG_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace klee {
+
+enum class EventKind : std::uint8_t {
+  PPC,      ///< partial path condition
+  Expr,     ///< expressions printed with klee_print_expr/klee_print_stmt
+  Trace,    ///< executed source locations
+  Concrete, ///< concretized reads
+  Taint,    ///< tainted values
+  Memory,   ///< tracked memory accesses
+};
+
+constexpr unsigned NumEventKinds = 6;
+
+/// Short name of the event kind, e.g. "ppc"
+const char *getEventKindName(EventKind kind);
+
+struct Event {
+  EventKind kind;
+  /// ID of the state the event belongs to
+  std::uint32_t stateID;
+  std::string text;
+};
+
+/// Destination of the logged events. Sinks are only called from the
+/// background writer, one batch of events at a time.
+class EventSink {
+public:
+  virtual ~EventSink() = default;
+  virtual void write(const std::vector<Event> &events) = 0;
+  virtual void flush() = 0;
+};
+
+/// Write each event kind to its own text file in the given directory
+/// (ppc.log, expr.log, trace.log, concrete.log, taint.log, memory.log), in
+/// the "KLEE: <prefix>: <text>" format of klee_message.
+std::unique_ptr<EventSink> createTextEventSink(const std::string &directory);
+
+/// Write all events as JSON lines, one object with kind, state and text
+/// fields per event.
+std::unique_ptr<EventSink> createJSONEventSink(const std::string &path);
+
+class EventLog {
+public:
+  /// Register a sink. Sinks can only be added before start().
+  static void addSink(std::unique_ptr<EventSink> sink);
+
+  /// Start the background writer. Events logged before are dropped.
+  static void start();
+
+  /// Drain all pending events, flush and close the sinks and stop the
+  /// background writer. Also done at exit.
+  static void stop();
+
+  /// Write and flush the pending events from the calling thread, without
+  /// stopping the log. Used when KLEE is about to exit abnormally.
+  static void flush();
+
+  /// Log an event, a no-op if the log has not been started.
+  static void log(EventKind kind, std::uint32_t stateID, std::string text);
+};
+
+} // namespace klee
+
+#endif /* KLEE_EVENTLOG_H */
@@ -16,6 +16,7 @@
 #include "llvm/IR/Module.h"
 
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -51,6 +52,19 @@ llvm::Function *getDirectCallTarget(const llvm::CallBase &cb,
 /// terminates in a direct call).
 bool functionEscapes(const llvm::Function *f);
 
+/// Return the functions whose calls only produce output: the output
+/// functions of the C library (printf, puts, ...) and the defined functions
+/// that write no memory but their own stack and only call such functions.
+/// Skipping a call to one of them whose result is unused does not change
+/// the state of the caller, except for the output and errors the call would
+/// have found.
+///
+/// @param keep functions that are not output-only, e.g. since they contain
+/// locations of interest, nor are their callers
+std::set<const llvm::Function *>
+getOutputOnlyFunctions(const llvm::Module &m,
+                       const std::set<const llvm::Function *> &keep = {});
+
 /// Loads the file libraryName and reads all possible modules out of it.
 ///
 /// Different file types are possible:
@@ -0,0 +1,75 @@
+//===-- ReplayLog.h ---------------------------------------------*- C++ -*-===//
+//
+//                     The KLEE Symbolic Virtual Machine
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// Log of the nondeterministic inputs of a run (random numbers, allocation
+// addresses, external calls, timer firings, memory usage), so that a run
+// recorded with --record-log can be repeated exactly with --replay-log.
+//
+// Events are appended in the order the interpreter consumes them. Replaying
+// hands back the recorded values in the same order and stops with an error
+// as soon as the run asks for an event of another kind than the next one in
+// the log.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef KLEE_REPLAYLOG_H
+#define KLEE_REPLAYLOG_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace klee {
+
+enum class ReplayEventKind : std::uint8_t {
+  Seed,           ///< initial seed of the RNG
+  Random,         ///< draw of random()
+  Allocation,     ///< address of an allocated object
+  ExternalCall,   ///< errno and return value of an external call
+  ExternalMemory, ///< bytes of an object changed by an external call
+  Timer,          ///< firing of a timer of a TimerGroup
+  MemoryUsage,    ///< memory usage in MB seen by the memory cap check
+};
+
+/// Short name of the event kind, e.g. "timer"
+const char *getReplayEventKindName(ReplayEventKind kind);
+
+class ReplayLog {
+public:
+  /// Start appending events to a new log at the given path.
+  static bool startRecording(const std::string &path, std::string &error);
+
+  /// Load a recorded log and start replaying it.
+  static bool startReplaying(const std::string &path, std::string &error);
+
+  /// Flush and close the recorded log, or warn about events left unreplayed.
+  static void stop();
+
+  static bool isRecording();
+  static bool isReplaying();
+
+  /// Append an event, a no-op unless recording.
+  static void record(ReplayEventKind kind, std::uint64_t value,
+                     const std::vector<std::uint8_t> &data = {});
+
+  /// Whether the next replayed event is of the given kind, without consuming
+  /// it.
+  static bool peek(ReplayEventKind kind, std::uint64_t &value);
+
+  /// Consume the next replayed event, which must be of the given kind.
+  static std::uint64_t replay(ReplayEventKind kind,
+                              std::vector<std::uint8_t> *data = nullptr);
+
+  /// Record the value, or return the recorded one instead when replaying.
+  static std::uint64_t sync(ReplayEventKind kind, std::uint64_t value);
+};
+
+} // namespace klee
+
+#endif /* KLEE_REPLAYLOG_H */
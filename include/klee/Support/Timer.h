@@ -14,6 +14,7 @@
 
 #include "llvm/ADT/SmallVector.h"
 
+#include <cstdint>
 #include <functional>
 #include <memory>
 
@@ -47,6 +48,8 @@ namespace klee {
     time::Point nextInvocationTime;
     /// The event callback.
     std::function<void()> run;
+
+    friend class TimerGroup;
   public:
     /// \param interval The time span between callback invocations.
     /// \param callback The event callback.
@@ -70,6 +73,9 @@ namespace klee {
    * All registered timer intervals should be larger than MI and also be multiples of MI.
    * Similar to Timer, a TimerGroup is _passive_ and needs to be `invoke`d by an external
    * caller.
+   * When recording a replay log, the firings of the registered timers are
+   * logged by the number of `invoke` calls; when replaying one, timers fire at
+   * the recorded calls instead of by wall time.
    */
   class TimerGroup {
     /// Registered timers.
@@ -78,6 +84,8 @@ namespace klee {
     Timer invocationTimer;
     /// Time of last `invoke` call.
     time::Point currentTime;
+    /// Number of `invoke` calls.
+    std::uint64_t invocations = 0;
   public:
     /// \param minInterval The minimum interval between invocations of registered timers.
     explicit TimerGroup(const time::Span &minInterval);
@@ -9,12 +9,14 @@
 
 #include "AddressSpace.h"
 
+#include "Context.h"
 #include "ExecutionState.h"
 #include "Memory.h"
 #include "TimingSolver.h"
 
 #include "klee/Expr/Expr.h"
 #include "klee/Statistics/TimerStatIncrementer.h"
+#include "klee/Support/ReplayLog.h"
 
 #include "CoreStats.h"
 
@@ -341,6 +343,92 @@ bool AddressSpace::copyInConcrete(const MemoryObject *mo, const ObjectState *os,
   return true;
 }
 
+bool AddressSpace::changedExternally() const {
+  for (const auto &obj : objects) {
+    const MemoryObject *mo = obj.first;
+    if (!mo->isUserSpecified &&
+        memcmp(reinterpret_cast<const void *>(mo->address),
+               obj.second->concreteStore, mo->size) != 0)
+      return true;
+  }
+  return false;
+}
+
+bool AddressSpace::appendConcreteContents(uint64_t address,
+                                          std::string &key) const {
+  ObjectPair op;
+  ref<ConstantExpr> pointer =
+      ConstantExpr::create(address, Context::get().getPointerWidth());
+  if (!resolveOne(pointer, op))
+    return true;
+  const MemoryObject *mo = op.first;
+  unsigned offset = address - mo->address;
+  if (!op.second->isRangeConcrete(offset, mo->size - offset))
+    return false;
+  key.append(reinterpret_cast<const char *>(&mo->id), sizeof(mo->id));
+  key.append(reinterpret_cast<const char *>(op.second->concreteStore) + offset,
+             mo->size - offset);
+  return true;
+}
+
+void AddressSpace::recordExternalChanges() const {
+  // Changed bytes of each object as runs of a 32 bit offset, a 32 bit length
+  // and the new bytes
+  for (const auto &obj : objects) {
+    const MemoryObject *mo = obj.first;
+    if (mo->isUserSpecified)
+      continue;
+    auto address = reinterpret_cast<const std::uint8_t *>(mo->address);
+    const std::uint8_t *store = obj.second->concreteStore;
+    std::vector<std::uint8_t> changes;
+    for (std::uint32_t i = 0; i < mo->size;) {
+      if (address[i] == store[i]) {
+        ++i;
+        continue;
+      }
+      std::uint32_t begin = i;
+      while (i < mo->size && address[i] != store[i])
+        ++i;
+      std::uint32_t run[2] = {begin, i - begin};
+      auto header = reinterpret_cast<const std::uint8_t *>(run);
+      changes.insert(changes.end(), header, header + sizeof(run));
+      changes.insert(changes.end(), address + begin, address + i);
+    }
+    if (!changes.empty())
+      ReplayLog::record(ReplayEventKind::ExternalMemory, mo->id, changes);
+  }
+}
+
+bool AddressSpace::replayExternalChanges() {
+  std::uint64_t id;
+  std::vector<std::uint8_t> changes;
+  while (ReplayLog::peek(ReplayEventKind::ExternalMemory, id)) {
+    ReplayLog::replay(ReplayEventKind::ExternalMemory, &changes);
+    const MemoryObject *mo = nullptr;
+    for (const auto &obj : objects) {
+      if (obj.first->id == id) {
+        mo = obj.first;
+        break;
+      }
+    }
+    if (!mo)
+      return false;
+
+    auto address = reinterpret_cast<std::uint8_t *>(mo->address);
+    for (std::size_t i = 0; i + 2 * sizeof(std::uint32_t) <= changes.size();) {
+      std::uint32_t run[2];
+      memcpy(run, &changes[i], sizeof(run));
+      i += sizeof(run);
+      if (run[0] + std::uint64_t(run[1]) > mo->size ||
+          changes.size() - i < run[1])
+        return false;
+      memcpy(address + run[0], &changes[i], run[1]);
+      i += run[1];
+    }
+  }
+  return true;
+}
+
 /***/
 
 bool MemoryObjectLT::operator()(const MemoryObject *a, const MemoryObject *b) const {
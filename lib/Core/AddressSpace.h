@@ -146,6 +146,27 @@ namespace klee {
     /// @return
     bool copyInConcrete(const MemoryObject *mo, const ObjectState *os,
                         uint64_t src_address);
+
+    /// Check whether an external call changed the actual system memory of
+    /// any object, before copyInConcretes.
+    bool changedExternally() const;
+
+    /// Append the concrete bytes from the given address to the end of the
+    /// object containing it, if any, to `key`.
+    ///
+    /// \return false if some of these bytes are symbolic.
+    bool appendConcreteContents(uint64_t address, std::string &key) const;
+
+    /// Log the bytes of the actual system memory that differ from the
+    /// concrete values after an external call, for --record-log.
+    void recordExternalChanges() const;
+
+    /// Write the logged bytes changed by an external call to the actual
+    /// system memory, for --replay-log, so that copyInConcretes picks them
+    /// up as if the call had made them.
+    ///
+    /// \return false if the log changes an object that does not exist.
+    bool replayExternalChanges();
   };
 } // End klee namespace
 
@@ -12,6 +12,7 @@
 #include "klee/Statistics/Statistics.h"
 
 #include "llvm/IR/Function.h"
+#include "llvm/IR/InstIterator.h"
 #include "llvm/Support/raw_ostream.h"
 
 #include <map>
@@ -21,10 +22,42 @@ using namespace klee;
 
 ///
 
+namespace {
+/// FNV-1a, so that hashes do not depend on addresses
+std::uint32_t hashBytes(std::uint32_t h, const void *data, std::size_t size) {
+  const auto *bytes = static_cast<const unsigned char *>(data);
+  for (std::size_t i = 0; i < size; ++i)
+    h = (h ^ bytes[i]) * 16777619u;
+  return h;
+}
+
+std::uint32_t computeContextHash(const CallPathNode *parent,
+                                 const llvm::Instruction *callSite,
+                                 const llvm::Function *function) {
+  if (!function)
+    return 0;
+  std::uint32_t h = parent ? parent->contextHash : 2166136261u;
+  llvm::StringRef name = function->getName();
+  h = hashBytes(h, name.data(), name.size());
+  if (callSite) {
+    // Distinguish call sites by their position in the caller
+    std::uint32_t position = 0;
+    for (const auto &inst : llvm::instructions(callSite->getFunction())) {
+      if (&inst == callSite)
+        break;
+      ++position;
+    }
+    h = hashBytes(h, &position, sizeof(position));
+  }
+  return h;
+}
+} // namespace
+
 CallPathNode::CallPathNode(CallPathNode *_parent,
                            const llvm::Instruction *_callSite,
                            const llvm::Function *_function)
-    : parent(_parent), callSite(_callSite), function(_function), count(0) {}
+    : parent(_parent), callSite(_callSite), function(_function), count(0),
+      contextHash(computeContextHash(_parent, _callSite, _function)) {}
 
 void CallPathNode::print() {
   llvm::errs() << "  (Function: " << this->function->getName() << ", "
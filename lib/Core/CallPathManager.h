@@ -12,6 +12,7 @@
 
 #include "klee/Statistics/Statistics.h"
 
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <vector>
@@ -55,6 +56,10 @@ namespace klee {
     StatisticRecord summaryStatistics;
     unsigned count;
 
+    /// Hash of the (callSite,function) path, stable across runs on the same
+    /// module, 0 for the root
+    std::uint32_t contextHash;
+
   public:
     CallPathNode(CallPathNode *parent, const llvm::Instruction *callSite,
                  const llvm::Function *function);
@@ -0,0 +1,265 @@
+//===-- ConcolicCampaign.cpp ------------------------------------*- C++ -*-===//
+//
+//                     The KLEE Symbolic Virtual Machine
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "ConcolicCampaign.h"
+
+#include "CoreStats.h"
+#include "ExecutionState.h"
+#include "Memory.h"
+#include "TimingSolver.h"
+
+#include "klee/ADT/KTest.h"
+#include "klee/Expr/Constraints.h"
+#include "klee/Module/InstructionInfoTable.h"
+#include "klee/Module/KInstruction.h"
+#include "klee/Statistics/Statistics.h"
+#include "klee/Support/ErrorHandling.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+using namespace klee;
+
+namespace {
+char *copyString(const char *s) {
+  char *res = strdup(s);
+  if (!res)
+    klee_error("out of memory");
+  return res;
+}
+
+void setBytes(KTestObject &o, const std::vector<unsigned char> &bytes) {
+  o.numBytes = bytes.size();
+  o.bytes = static_cast<unsigned char *>(malloc(o.numBytes ? o.numBytes : 1));
+  if (!o.bytes)
+    klee_error("out of memory");
+  memcpy(o.bytes, bytes.data(), o.numBytes);
+}
+
+/// Deep copy of a KTest, to be released with kTest_free
+KTest *copyKTest(const KTest *in, unsigned extraObjects = 0) {
+  KTest *res = static_cast<KTest *>(calloc(1, sizeof(KTest)));
+  if (!res)
+    klee_error("out of memory");
+  res->version = in->version;
+  res->numArgs = in->numArgs;
+  res->args = static_cast<char **>(calloc(in->numArgs + 1, sizeof(char *)));
+  for (unsigned i = 0; i < in->numArgs; ++i)
+    res->args[i] = copyString(in->args[i]);
+  res->symArgvs = in->symArgvs;
+  res->symArgvLen = in->symArgvLen;
+  res->numObjects = in->numObjects;
+  res->objects = static_cast<KTestObject *>(
+      calloc(in->numObjects + extraObjects + 1, sizeof(KTestObject)));
+  if (!res->args || !res->objects)
+    klee_error("out of memory");
+  for (unsigned i = 0; i < in->numObjects; ++i) {
+    const KTestObject &o = in->objects[i];
+    res->objects[i].name = copyString(o.name);
+    setBytes(res->objects[i],
+             std::vector<unsigned char>(o.bytes, o.bytes + o.numBytes));
+  }
+  return res;
+}
+} // namespace
+
+std::vector<ConcolicDecision>
+klee::getFlippedPrefix(const std::vector<ConcolicBranch> &branches,
+                       std::size_t flipped) {
+  std::vector<ConcolicDecision> prefix;
+  prefix.reserve(flipped + 1);
+  for (std::size_t i = 0; i <= flipped; ++i)
+    prefix.push_back(
+        ConcolicDecision{branches[i].ki->info->assemblyLine, branches[i].direction});
+  prefix.back().direction = !prefix.back().direction;
+  return prefix;
+}
+
+bool klee::writeConcolicPrefix(const std::string &path,
+                               const std::vector<ConcolicDecision> &prefix) {
+  std::ofstream f(path);
+  for (const auto &decision : prefix)
+    f << decision.assemblyLine << ' ' << decision.direction << '\n';
+  return f.good();
+}
+
+bool klee::readConcolicPrefix(const std::string &path,
+                              std::vector<ConcolicDecision> &prefix) {
+  std::ifstream f(path);
+  if (!f.good())
+    return false;
+  prefix.clear();
+  ConcolicDecision decision;
+  while (f >> decision.assemblyLine >> decision.direction)
+    prefix.push_back(decision);
+  return f.eof();
+}
+
+ConcolicCampaign::Path::~Path() { kTest_free(seed); }
+
+std::uint64_t ConcolicCampaign::score(const ConcolicBranch &branch) {
+  const StatisticManager &sm = *theStatisticManager;
+  const KInstruction *ki = branch.untakenTarget;
+  if (ki && !sm.getIndexedValue(stats::coveredInstructions, ki->info->id))
+    return 0;
+  if (!ki)
+    ki = branch.ki;
+  // 0 means no uncovered instruction is reachable
+  std::uint64_t dist = sm.getIndexedValue(stats::minDistToUncovered,
+                                          ki->info->id);
+  return dist ? dist : std::numeric_limits<std::uint64_t>::max();
+}
+
+void ConcolicCampaign::addPath(const ExecutionState &state,
+                               const KTest *seed) {
+  if (state.concolicBranches.size() <= currentBound)
+    return;
+
+  auto path = std::make_shared<Path>();
+  path->seed = copyKTest(seed);
+  path->constraints = state.concolicConstraints;
+  path->branches = state.concolicBranches;
+  path->generation = currentGeneration + 1;
+  for (const auto &symbolic : state.symbolics) {
+    path->objects.push_back(symbolic.second);
+    path->names.push_back(symbolic.first->name);
+  }
+
+  std::size_t end = std::min(path->branches.size(), currentLimit);
+  for (std::size_t i = currentBound; i < end; ++i) {
+    if (!zesti) {
+      candidates.push(Candidate{path, i, score(path->branches[i]),
+                                std::numeric_limits<std::size_t>::max(),
+                                nextOrder++});
+      continue;
+    }
+    std::size_t distance = getSensitiveDistance(state.sensitiveOperations, i);
+    if (distance)
+      candidates.push(Candidate{path, i, distance, distance, nextOrder++});
+  }
+}
+
+std::size_t ConcolicCampaign::getSensitiveDistance(
+    const std::vector<std::size_t> &operations, std::size_t branch) {
+  // An operation after `branch` branches follows the branch
+  auto it = std::upper_bound(operations.begin(), operations.end(), branch);
+  return it == operations.end() ? 0 : *it - branch;
+}
+
+bool ConcolicCampaign::solveFlipped(
+    TimingSolver &solver, time::Span timeout,
+    const std::vector<ref<Expr>> &constraints, const ConcolicBranch &branch,
+    const std::vector<const Array *> &objects,
+    std::vector<std::vector<unsigned char>> &values) {
+  ConstraintSet prefix;
+  ConstraintManager cm(prefix);
+  for (std::size_t i = 0; i < branch.prefixLength; ++i)
+    cm.addConstraint(constraints[i]);
+  ref<Expr> negated = ConstraintManager::simplifyExpr(
+      prefix, Expr::createIsZero(branch.condition));
+  if (negated->isFalse())
+    return false;
+  cm.addConstraint(negated);
+
+  SolverQueryMetaData metaData;
+  solver.setTimeout(timeout);
+  bool feasible = solver.getInitialValues(prefix, objects, values, metaData);
+  solver.setTimeout(time::Span());
+  return feasible;
+}
+
+KTest *ConcolicCampaign::makeSeed(
+    const KTest *seed, const std::vector<std::string> &names,
+    const std::vector<std::vector<unsigned char>> &values) {
+  // Keep the seed's objects (and their order), replacing the symbolic ones
+  KTest *next = copyKTest(seed, names.size());
+  std::vector<bool> replaced(next->numObjects, false);
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    unsigned k = 0;
+    while (k < next->numObjects &&
+           (replaced[k] || names[i] != next->objects[k].name))
+      ++k;
+    if (k == next->numObjects) {
+      next->objects[k].name = copyString(names[i].c_str());
+      ++next->numObjects;
+      replaced.push_back(true);
+    } else {
+      free(next->objects[k].bytes);
+      replaced[k] = true;
+    }
+    setBytes(next->objects[k], values[i]);
+  }
+  return next;
+}
+
+std::string ConcolicCampaign::inputKey(
+    const std::vector<std::vector<unsigned char>> &values) {
+  // Each value is prefixed with its size, so that no two lists of values
+  // share a key
+  std::string key;
+  for (const auto &value : values) {
+    std::uint64_t size = value.size();
+    key.append(reinterpret_cast<const char *>(&size), sizeof(size));
+    key.append(value.begin(), value.end());
+  }
+  return key;
+}
+
+KTest *ConcolicCampaign::getNextSeed(TimingSolver &solver,
+                                     time::Span timeout,
+                                     std::vector<ConcolicDecision> &prefix) {
+  while (runs < maxRuns && !candidates.empty()) {
+    Candidate candidate = candidates.top();
+    candidates.pop();
+
+    // Coverage changed since the candidate was scored, try the others first
+    // if it got worse
+    std::uint64_t current =
+        zesti ? candidate.score
+              : score(candidate.path->branches[candidate.branch]);
+    if (current > candidate.score && !candidates.empty() &&
+        current > candidates.top().score) {
+      candidate.score = current;
+      candidates.push(candidate);
+      continue;
+    }
+
+    const Path &path = *candidate.path;
+    const ConcolicBranch &branch = path.branches[candidate.branch];
+    std::vector<std::vector<unsigned char>> values;
+    if (!solveFlipped(solver, timeout, path.constraints, branch, path.objects,
+                      values))
+      continue;
+    if (!triedInputs.insert(inputKey(values)).second)
+      continue;
+
+    KTest *next = makeSeed(path.seed, path.names, values);
+    prefix = getFlippedPrefix(path.branches, candidate.branch);
+    ++runs;
+    currentBound = candidate.branch + 1;
+    const std::size_t unbounded = std::numeric_limits<std::size_t>::max();
+    currentLimit = candidate.budget > unbounded - currentBound
+                       ? unbounded
+                       : currentBound + candidate.budget;
+    currentGeneration = path.generation;
+    const InstructionInfo &info = *branch.ki->info;
+    if (zesti)
+      klee_message("zesti run %u: negating branch at %s:%u, %" PRIu64
+                   " branches before a sensitive operation",
+                   runs, info.file.c_str(), info.line, candidate.score);
+    else
+      klee_message("concolic run %u (generation %u): negating branch at %s:%u",
+                   runs, currentGeneration, info.file.c_str(), info.line);
+    return next;
+  }
+  return nullptr;
+}
@@ -0,0 +1,200 @@
+//===-- ConcolicCampaign.h --------------------------------------*- C++ -*-===//
+//
+//                     The KLEE Symbolic Virtual Machine
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+/**
+ * @file ConcolicCampaign.h
+ * @brief Generational concolic search across seeded runs
+ *
+ * With --concolic-runs, every seeded run records the constraints added on
+ * its path and the symbolic branches it took. When a state terminates, each
+ * branch becomes a candidate: the path constraints before the branch and the
+ * negated branch condition. Candidates are ordered by the distance of the
+ * branch side not taken to uncovered code, as computed by the StatsTracker.
+ * The next seed is the solution of the best feasible candidate, found with a
+ * single solver query, and only branches past the negated one are candidates
+ * in the run it drives (the earlier ones belong to its parent's path).
+ *
+ * In ZESTI mode (--zesti), candidates are instead the branches that precede
+ * a sensitive operation on the path (a memory access with a symbolic offset
+ * or a division by a symbolic divisor), ordered by their distance to it: the
+ * number of symbolic branches from the branch to the operation. The run
+ * driven by a negated branch may in turn only negate the branches within
+ * that distance after it, which bounds the exploration around each flip.
+ *
+ * A derived seed comes with the directions of the branches its parent took
+ * up to and including the negated one. The run it drives follows them
+ * without concretizing and querying the solver, so only the new suffix of
+ * the path costs solver time.
+ */
+
+#ifndef KLEE_CONCOLICCAMPAIGN_H
+#define KLEE_CONCOLICCAMPAIGN_H
+
+#include "klee/Expr/Expr.h"
+#include "klee/System/Time.h"
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <queue>
+#include <set>
+#include <string>
+#include <vector>
+
+struct KTest;
+
+namespace klee {
+class ExecutionState;
+struct KInstruction;
+class TimingSolver;
+
+/// A symbolic branch taken on a seeded path
+struct ConcolicBranch {
+  /// Number of path constraints added before the branch
+  std::size_t prefixLength;
+  /// The branch condition as taken
+  ref<Expr> condition;
+  /// The branch instruction
+  KInstruction *ki;
+  /// First instruction of the successor not taken, if known
+  KInstruction *untakenTarget;
+  /// Whether the branch condition was true
+  bool direction;
+};
+
+/// Direction of a symbolic branch, enough to follow it again without the
+/// solver
+struct ConcolicDecision {
+  /// Line of the branch instruction in assembly.ll, which unlike the
+  /// InstructionInfo id is the same in every run
+  unsigned assemblyLine;
+  bool direction;
+};
+
+/// The decisions of the branches before the given one, followed by the
+/// negated branch
+std::vector<ConcolicDecision>
+getFlippedPrefix(const std::vector<ConcolicBranch> &branches,
+                 std::size_t flipped);
+
+/// Write decisions to a prefix file, one "assemblyLine direction" pair per
+/// line
+/// \return false if the file cannot be written
+bool writeConcolicPrefix(const std::string &path,
+                         const std::vector<ConcolicDecision> &prefix);
+
+/// Read a file written by writeConcolicPrefix
+/// \return false if the file cannot be read or is malformed
+bool readConcolicPrefix(const std::string &path,
+                        std::vector<ConcolicDecision> &prefix);
+
+class ConcolicCampaign {
+  /// Path of a terminated state, shared by its candidates
+  struct Path {
+    /// Copy of the seed that drove the path
+    KTest *seed;
+    std::vector<ref<Expr>> constraints;
+    std::vector<ConcolicBranch> branches;
+    std::vector<const Array *> objects;
+    std::vector<std::string> names;
+    unsigned generation;
+
+    ~Path();
+  };
+
+  struct Candidate {
+    std::shared_ptr<Path> path;
+    /// Index of the branch to negate
+    std::size_t branch;
+    std::uint64_t score;
+    /// Number of branches after the negated one that the run it drives may
+    /// negate
+    std::size_t budget;
+    /// Insertion order, to break ties
+    std::uint64_t order;
+
+    bool operator<(const Candidate &other) const {
+      // std::priority_queue is a max-heap, prefer low scores and old
+      // candidates
+      if (score != other.score)
+        return score > other.score;
+      return order > other.order;
+    }
+  };
+
+  std::priority_queue<Candidate> candidates;
+  std::uint64_t nextOrder = 0;
+
+  /// Inputs already derived, to avoid running the same input twice
+  std::set<std::string> triedInputs;
+
+  unsigned maxRuns;
+  unsigned runs = 1;
+  bool zesti;
+
+  /// Branches of the current run that can be negated, [bound, limit), and
+  /// its generation
+  std::size_t currentBound = 0;
+  std::size_t currentLimit = std::numeric_limits<std::size_t>::max();
+  unsigned currentGeneration = 0;
+
+  static std::uint64_t score(const ConcolicBranch &branch);
+
+public:
+  /// \param zesti Whether to order candidates by their distance to
+  /// sensitive operations rather than to uncovered code
+  ConcolicCampaign(unsigned maxRuns, bool zesti = false)
+      : maxRuns(maxRuns), zesti(zesti) {}
+
+  /// Number of symbolic branches from a branch to the first sensitive
+  /// operation after it, 1 if no other branch is in between
+  /// \param operations ExecutionState::sensitiveOperations of the path
+  /// \return 0 if no sensitive operation follows the branch
+  static std::size_t
+  getSensitiveDistance(const std::vector<std::size_t> &operations,
+                       std::size_t branch);
+
+  /// Add the branches of a state terminating in the current run
+  /// \param seed The seed that drove the state
+  void addPath(const ExecutionState &state, const KTest *seed);
+
+  /// Derive the seed of the next run by negating the best feasible
+  /// candidate branch
+  /// \param prefix The decisions the new seed follows, see getFlippedPrefix
+  /// \return a new KTest owned by the caller, or nullptr if there are no
+  /// runs or candidates left
+  KTest *getNextSeed(TimingSolver &solver, time::Span timeout,
+                     std::vector<ConcolicDecision> &prefix);
+
+  unsigned getNumRuns() const { return runs; }
+
+  /// Solve the constraints of a path before a branch together with the
+  /// negated branch condition
+  /// \param constraints The constraints added on the path
+  /// \param values The solution for objects, if feasible
+  /// \return true if the negated branch is feasible
+  static bool solveFlipped(TimingSolver &solver, time::Span timeout,
+                           const std::vector<ref<Expr>> &constraints,
+                           const ConcolicBranch &branch,
+                           const std::vector<const Array *> &objects,
+                           std::vector<std::vector<unsigned char>> &values);
+
+  /// Copy a seed, replacing the objects with the given names by values
+  /// \return a new KTest owned by the caller
+  static KTest *makeSeed(const KTest *seed,
+                         const std::vector<std::string> &names,
+                         const std::vector<std::vector<unsigned char>> &values);
+
+  /// Key identifying a solution, to skip inputs already derived
+  static std::string
+  inputKey(const std::vector<std::vector<unsigned char>> &values);
+};
+} // namespace klee
+
+#endif /* KLEE_CONCOLICCAMPAIGN_H */
@@ -30,6 +30,15 @@ namespace stats {
   /// The number of process forks.
   extern Statistic forks;
 
+  /// The number of external calls answered by --cache-external-calls.
+  extern Statistic cachedExternalCalls;
+
+  /// The number of calls run natively by --native-leaf-functions.
+  extern Statistic nativeCalls;
+
+  /// The number of unsolved constraints dropped by --seed-timeout-fallback.
+  extern Statistic droppedConstraints;
+
   /// Number of states, this is a "fake" statistic used by istats, it
   /// isn't normally up-to-date.
   extern Statistic states;
@@ -96,6 +96,12 @@ ExecutionState::ExecutionState(const ExecutionState& state):
     pathOS(state.pathOS),
     symPathOS(state.symPathOS),
     coveredLines(state.coveredLines),
+    edgeCoverage(state.edgeCoverage),
+    concolicConstraints(state.concolicConstraints),
+    concolicBranches(state.concolicBranches),
+    sensitiveOperations(state.sensitiveOperations),
+    seedPrefixPosition(state.seedPrefixPosition),
+    externalArgumentValues(state.externalArgumentValues),
     symbolics(state.symbolics),
     cexPreferences(state.cexPreferences),
     arrayNames(state.arrayNames),
@@ -115,10 +121,13 @@ ExecutionState::ExecutionState(const ExecutionState& state):
 ExecutionState *ExecutionState::branch() {
   depth++;
 
+  // The lines newly covered stay with this state, don't copy them
+  auto lines = std::move(coveredLines);
+  coveredLines.clear();
   auto *falseState = new ExecutionState(*this);
+  coveredLines = std::move(lines);
   falseState->setID();
   falseState->coveredNew = false;
-  falseState->coveredLines.clear();
 
   return falseState;
 }
@@ -11,15 +11,18 @@
 #define KLEE_EXECUTIONSTATE_H
 
 #include "AddressSpace.h"
+#include "ConcolicCampaign.h"
 #include "FunctionStateInfo.h"
 #include "MergeHandler.h"
 
+#include "klee/ADT/ImmutableMap.h"
 #include "klee/ADT/ImmutableSet.h"
 #include "klee/ADT/TreeStream.h"
 #include "klee/Expr/Constraints.h"
 #include "klee/Expr/Expr.h"
 #include "klee/Module/KInstIterator.h"
 #include "klee/Solver/Solver.h"
+#include "klee/Support/CoverageMap.h"
 #include "klee/System/Time.h"
 
 #include "llvm/IR/DataLayout.h"
@@ -202,8 +205,34 @@ public:
   TreeOStream symPathOS;
 
   /// @brief Set containing which lines in which files are covered by this state
+  ///
+  /// Only lines no state had covered before are added.  branch() leaves them
+  /// with this state, but any other copy of the state still copies the set.
   std::map<const std::string *, std::set<std::uint32_t>> coveredLines;
 
+  /// @brief Bitmap of the control flow edges taken on the path to this
+  /// state, shared with forked states until either adds an edge
+  std::shared_ptr<CoverageMap> edgeCoverage;
+
+  /// @brief Constraints added on a seeded path and the symbolic branches
+  /// taken, recorded for the concolic campaign (--concolic-runs)
+  std::vector<ref<Expr>> concolicConstraints;
+  std::vector<ConcolicBranch> concolicBranches;
+
+  /// @brief Number of symbolic branches taken before each sensitive
+  /// operation (symbolic memory offset or divisor) on a seeded path, in
+  /// path order, for the ZESTI campaign (--zesti)
+  std::vector<std::size_t> sensitiveOperations;
+
+  /// @brief Number of symbolic branches on a seeded path, the index of the
+  /// next decision to follow from the seed prefix (--seed-prefix)
+  std::size_t seedPrefixPosition = 0;
+
+  /// @brief Values of the symbolic arguments of external calls on this
+  /// path, reused for the same arguments: implied by the path constraints,
+  /// or taken from the state's only seed in seeded mode
+  ImmutableMap<ref<Expr>, ref<ConstantExpr>> externalArgumentValues;
+
   /// @brief Pointer to the process tree of the current state
   /// Copies of ExecutionState should not copy ptreeNode
   PTreeNode *ptreeNode = nullptr;
@@ -223,6 +252,7 @@ public:
   /// @brief The objects handling the klee_open_merge calls this state ran through
   std::vector<ref<MergeHandler>> openMergeStack;
 
+
   /// @brief The numbers of times this state has run through Executor::stepInstruction
   std::uint64_t steppedInstructions = 0;
 
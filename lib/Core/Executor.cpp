@@ -10,8 +10,10 @@
 #include "Executor.h"
 
 #include "Context.h"
+#include "ConcolicCampaign.h"
 #include "CoreStats.h"
 #include "ExecutionState.h"
+#include "ExprProfiler.h"
 #include "ExternalDispatcher.h"
 #include "GetElementPtrTypeIterator.h"
 #include "ImpliedValue.h"
@@ -22,6 +24,7 @@
 #include "SeedInfo.h"
 #include "SpecialFunctionHandler.h"
 #include "StatsTracker.h"
+#include "TaintTracker.h"
 #include "TimingSolver.h"
 #include "UserSearcher.h"
 
@@ -45,11 +48,14 @@
 #include "klee/Solver/SolverStats.h"
 #include "klee/Statistics/TimerStatIncrementer.h"
 #include "klee/Support/Casting.h"
+#include "klee/Support/DependencyIndex.h"
 #include "klee/Support/ErrorHandling.h"
+#include "klee/Support/EventLog.h"
 #include "klee/Support/FileHandling.h"
 #include "klee/Support/FloatEvaluation.h"
 #include "klee/Support/ModuleUtil.h"
 #include "klee/Support/OptionCategories.h"
+#include "klee/Support/ReplayLog.h"
 #include "klee/System/MemoryUsage.h"
 #include "klee/System/Time.h"
 
@@ -174,6 +180,28 @@ cl::opt<bool>
                                   "querying the solver (default=true)"),
                          cl::cat(SolvingCat));
 
+cl::opt<bool> SkipProvenChecks(
+    "skip-proven-checks", cl::init(true),
+    cl::desc("Skip the calls to klee_div_zero_check and klee_overshift_check "
+             "whose condition holds on every path, remembering the symbolic "
+             "conditions already proven (default=true)"),
+    cl::cat(SolvingCat));
+
+cl::opt<bool> AdaptiveSolverTimeout(
+    "adaptive-solver-timeout", cl::init(false),
+    cl::desc("Time out the solver queries of a path after a multiple of the "
+             "99th percentile of the core solver query times of the current "
+             "run, once enough queries have been timed.  Queries answered by "
+             "the caches and test generation queries are not timed.  "
+             "--max-solver-time remains the upper bound (default=false)"),
+    cl::cat(SolvingCat));
+
+cl::opt<unsigned> AdaptiveSolverTimeoutFactor(
+    "adaptive-solver-timeout-factor", cl::init(10),
+    cl::desc("Multiple of the 99th percentile of the query times used by "
+             "--adaptive-solver-timeout (default=10)"),
+    cl::cat(SolvingCat));
+
 
 /*** External call policy options ***/
 
@@ -201,6 +229,16 @@ cl::opt<ExternalCallPolicy> ExternalCalls(
     cl::init(ExternalCallPolicy::Concrete),
     cl::cat(ExtCallsCat));
 
+cl::list<std::string> CacheExternalCalls(
+    "cache-external-calls", cl::CommaSeparated,
+    cl::desc("Reuse the result of a call to one of these external functions "
+             "for later calls with the same arguments, errno and contents of "
+             "the objects the arguments point to, if the call changed no "
+             "memory. Only for functions without other side effects "
+             "(default=none)"),
+    cl::value_desc("function1,function2,..."),
+    cl::cat(ExtCallsCat));
+
 cl::opt<bool> SuppressExternalWarnings(
     "suppress-external-warnings",
     cl::init(false),
@@ -214,6 +252,19 @@ cl::opt<bool> AllExternalWarnings(
              "as opposed to once per function (default=false)"),
     cl::cat(ExtCallsCat));
 
+cl::opt<bool> NativeLeafFunctions(
+    "native-leaf-functions", cl::init(false),
+    cl::desc("Run the calls with concrete arguments to defined leaf "
+             "functions natively with the JIT instead of interpreting them. "
+             "Only pure arithmetic functions qualify: integer and floating "
+             "point arguments and result, and memory accesses only to their "
+             "own stack at constant, in-bounds offsets. No copy of the "
+             "state's memory is made. Their instructions are not counted as "
+             "covered, and a native call is not interrupted by --max-time, "
+             "--max-instruction-time or the timers, so a function that does "
+             "not terminate hangs KLEE (default=false)"),
+    cl::cat(ExtCallsCat));
+
 
 /*** Seeding options ***/
 
@@ -268,6 +319,64 @@ cl::opt<std::string>
                       "search (default=0s (off))"),
              cl::cat(SeedingCat));
 
+cl::opt<bool> SeedTimeoutFallback(
+    "seed-timeout-fallback", cl::init(false),
+    cl::desc("When a solver query of a seeded state times out, follow the "
+             "value of the seed instead of terminating the state, and log the "
+             "unsolved constraint as dropped with --log-ppc (default=false)"),
+    cl::cat(SeedingCat));
+
+cl::opt<unsigned> ConcolicRuns(
+    "concolic-runs", cl::init(0),
+    cl::desc("Run a generational concolic campaign of this many seeded "
+             "runs, each following the seed derived by negating the branch "
+             "closest to uncovered code in the previous runs (default=0 "
+             "(off))"),
+    cl::cat(SeedingCat));
+
+cl::opt<bool> Zesti(
+    "zesti", cl::init(false),
+    cl::desc("Order the branches negated by --concolic-runs like ZESTI: only "
+             "branches leading to a memory access with a symbolic offset or a "
+             "division by a symbolic divisor, closest first, each run only "
+             "negating branches within that distance after its negated "
+             "branch (default=false)"),
+    cl::cat(SeedingCat));
+
+cl::opt<bool> FlipBranches(
+    "flip-branches", cl::init(false),
+    cl::desc("At the end of every seeded path, write a seed for each symbolic "
+             "branch it took, with the branch negated, to flipNNNNNN.ktest "
+             "(default=false)"),
+    cl::cat(SeedingCat));
+
+cl::opt<std::string> SeedPrefix(
+    "seed-prefix",
+    cl::desc("Follow the branch decisions in this file (flipNNNNNN.prefix, "
+             "written with a flipped seed) without the solver, as long as "
+             "the seeded path matches them (default=none)"),
+    cl::cat(SeedingCat));
+
+cl::opt<bool> ShadowTaint(
+    "shadow-taint", cl::init(false),
+    cl::desc("Keep inputs concrete (replayed with --replay-ktest-file) and "
+             "track which input bytes reach which instructions with shadow "
+             "labels instead of expressions, written to taint.idx "
+             "(default=false)"),
+    cl::cat(TestGenCat));
+
+cl::opt<bool> WriteDepIndex(
+    "write-dep-index", cl::init(false),
+    cl::desc("Write the symbolic input bytes read by the conditions of every "
+             "branch site to deps.idx (default=false)"),
+    cl::cat(SeedingCat));
+
+cl::opt<std::string> FlipBranchesFilter(
+    "flip-branches-filter",
+    cl::desc("Only flip branches in source files whose path contains this "
+             "string (default=all)"),
+    cl::cat(SeedingCat));
+
 
 /*** Termination criteria options ***/
 
@@ -373,6 +482,10 @@ cl::opt<unsigned> MaxStaticPctCheckDelay(
     cl::init(1000),
     cl::cat(TerminationCat));
 
+/// The --max-static-*-pct limits are recomputed once the total forks or
+/// solver time has grown by 1/StaticPctLimitsStep
+const std::uint64_t StaticPctLimitsStep = 16;
+
 cl::opt<std::string> TimerInterval(
     "timer-interval",
     cl::desc("Minimum interval to check timers. "
@@ -431,6 +544,28 @@ cl::opt<bool> DebugCheckForImpliedValues(
     cl::desc("Debug the implied value optimization"),
     cl::cat(DebugCat));
 
+cl::opt<bool> DumpExprProfile(
+    "dump-expr-profile", cl::init(false),
+    cl::desc("Write the largest symbolic value computed by each instruction "
+             "to expr-profile.txt, to find the source locations behind an "
+             "expression blow-up. Slows down execution (default=false)"),
+    cl::cat(DebugCat));
+
+cl::opt<bool> RecordLog(
+    "record-log", cl::init(false),
+    cl::desc("Log the nondeterministic inputs of the run (random numbers, "
+             "allocation addresses, external calls, timer firings and memory "
+             "usage) to replay.log, to repeat the run with --replay-log "
+             "(default=false)"),
+    cl::cat(DebugCat));
+
+cl::opt<std::string> ReplayLogFile(
+    "replay-log",
+    cl::desc("Repeat a run recorded with --record-log, taking its "
+             "nondeterministic inputs from the given log instead of the host "
+             "(default=off)"),
+    cl::cat(DebugCat));
+
 cl::opt<bool> DisableMemoryCheck(
     "dis-mem-check", cl::init(false),
     cl::desc("Switch off memory violation checking (default=off)"));
@@ -476,9 +611,23 @@ cl::opt<std::string> TraceFilter(
     "trace-filter", cl::init(""),
     cl::desc("filter criteria for the trace log (default=None)"));
 
+cl::opt<bool> SkipOutputCalls(
+    "skip-output-calls", cl::init(false),
+    cl::desc("Skip the calls with an unused result to printf, puts and the "
+             "like, and to the functions that only call them and write no "
+             "memory but their stack. For runs that only care about the path "
+             "condition or --hit-locations, functions containing a hit "
+             "location are kept (default=off)"));
+
 cl::opt<bool> ResolvePath(
     "resolve-path", cl::init(false),
     cl::desc("In seed mode resolve path using seed values (default=off)"));
+
+cl::opt<bool> SymbolicFP(
+    "symbolic-fp", cl::init(false),
+    cl::desc("Keep float and double operations on symbolic values symbolic "
+             "instead of concretizing them, requires the Z3 solver "
+             "(default=off)"));
 } // namespace
 
 // XXX hack
@@ -495,6 +644,19 @@ Executor::Executor(LLVMContext &ctx, const InterpreterOptions &opts,
       ivcEnabled(false), debugLogBuffer(debugBufferString) {
 
 
+  if (RecordLog && !ReplayLogFile.empty())
+    klee_error("--record-log and --replay-log are mutually exclusive");
+  std::string logError;
+  if (RecordLog &&
+      !ReplayLog::startRecording(
+          interpreterHandler->getOutputFilename("replay.log"), logError))
+    klee_error("unable to record replay.log: %s", logError.c_str());
+  if (!ReplayLogFile.empty() &&
+      !ReplayLog::startReplaying(ReplayLogFile, logError))
+    klee_error("unable to replay %s: %s", ReplayLogFile.c_str(),
+               logError.c_str());
+  theRNG.seed(ReplayLog::sync(ReplayEventKind::Seed, theRNG.getSeed()));
+
   const time::Span maxTime{MaxTime};
   if (maxTime) timers.add(
         std::make_unique<Timer>(maxTime, [&]{
@@ -502,8 +664,13 @@ Executor::Executor(LLVMContext &ctx, const InterpreterOptions &opts,
         setHaltExecution(true);
       }));
 
+  if (SymbolicFP && CoreSolverToUse != Z3_SOLVER)
+    klee_error("--symbolic-fp requires --solver-backend=z3");
+
   coreSolverTimeout = time::Span{MaxCoreSolverTime};
-  if (coreSolverTimeout) UseForkedCoreSolver = true;
+  // Z3 stops a query in process, STP and metaSMT only in a forked child
+  if (coreSolverTimeout || AdaptiveSolverTimeout)
+    UseForkedCoreSolver = true;
   Solver *coreSolver = klee::createCoreSolver(CoreSolverToUse);
   if (!coreSolver) {
     klee_error("Failed to create core solver\n");
@@ -517,8 +684,24 @@ Executor::Executor(LLVMContext &ctx, const InterpreterOptions &opts,
       interpreterHandler->getOutputFilename(SOLVER_QUERIES_KQUERY_FILE_NAME));
 
   this->solver = new TimingSolver(solver, EqualitySubstitution);
+  if (AdaptiveSolverTimeout)
+    this->solver->queryTimes = &queryTimes;
   memory = new MemoryManager(&arrayCache);
 
+  if (Zesti && !ConcolicRuns)
+    klee_error("--zesti requires --concolic-runs");
+  if (ConcolicRuns)
+    concolicCampaign =
+        std::make_unique<ConcolicCampaign>(ConcolicRuns, Zesti);
+  if (WriteDepIndex)
+    dependencyIndex = std::make_unique<DependencyIndex>();
+  if (ShadowTaint)
+    taintTracker = std::make_unique<TaintTracker>();
+  if (DumpExprProfile)
+    exprProfiler = std::make_unique<ExprProfiler>();
+  if (!SeedPrefix.empty() && !readConcolicPrefix(SeedPrefix, seedPrefix))
+    klee_error("unable to read seed prefix %s", SeedPrefix.c_str());
+
   initializeSearchOptions();
 
   if (OnlyOutputStatesCoveringNew && !StatsTracker::useIStats())
@@ -596,11 +779,31 @@ Executor::setModule(std::vector<std::unique_ptr<llvm::Module>> &modules,
 
   specialFunctionHandler->bind();
 
-  if (StatsTracker::useStatistics() || userSearcherRequiresMD2U()) {
+  if (NativeLeafFunctions) {
+    for (const auto &kf : kmodule->functions)
+      if (ExternalDispatcher::canExecuteNatively(*kf->function))
+        nativeFunctions.insert(kf->function);
+    klee_message("running %zu functions natively on concrete arguments",
+                 nativeFunctions.size());
+  }
+
+  if (SkipProvenChecks) {
+    divZeroCheckFunction = kmodule->module->getFunction("klee_div_zero_check");
+    overshiftCheckFunction =
+        kmodule->module->getFunction("klee_overshift_check");
+  }
+
+  // The concolic campaign ranks branches by their distance to uncovered code
+  bool requiresMD2U = userSearcherRequiresMD2U() || ConcolicRuns;
+  // The calling context of an edge is the call path node of its frame
+  if (interpreterOpts.CoverageMapContext && !StatsTracker::useCallPaths())
+    klee_error("--cov-map-context requires --output-istats and "
+               "--use-call-paths");
+  if (StatsTracker::useStatistics() || requiresMD2U) {
     statsTracker = 
       new StatsTracker(*this,
                        interpreterHandler->getOutputFilename("assembly.ll"),
-                       userSearcherRequiresMD2U());
+                       requiresMD2U);
   }
 
   // Initialize the context.
@@ -612,6 +815,7 @@ Executor::setModule(std::vector<std::unique_ptr<llvm::Module>> &modules,
 }
 
 Executor::~Executor() {
+  ReplayLog::stop();
   delete memory;
   delete externalDispatcher;
   delete specialFunctionHandler;
@@ -932,6 +1136,7 @@ void Executor::branch(ExecutionState &state,
     }
   } else {
     stats::forks += N-1;
+    state.prevPC->forks += N-1;
 
     // XXX do proper balance or keep random?
     result.push_back(&state);
@@ -996,6 +1201,32 @@ void Executor::branch(ExecutionState &state,
       addConstraint(*result[i], conditions[i]);
 }
 
+void Executor::updateStaticPctLimits() {
+  const std::uint64_t unlimited = std::numeric_limits<std::uint64_t>::max();
+  StaticPctLimits &limits = staticPctLimits;
+  std::uint64_t forks = stats::forks, solverTime = stats::solverTime;
+
+  // These checks are performed only after at least MaxStaticPctCheckDelay forks
+  // have been performed since execution started
+  if (forks < MaxStaticPctCheckDelay) {
+    limits.forks = limits.cpForks = unlimited;
+    limits.solverTime = limits.cpSolverTime = unlimited;
+    limits.nextForks = MaxStaticPctCheckDelay;
+    limits.nextSolverTime = unlimited;
+    return;
+  }
+
+  auto limit = [unlimited](std::uint64_t total, double pct) {
+    return pct < 1. ? static_cast<std::uint64_t>(total * pct) : unlimited;
+  };
+  limits.forks = limit(forks, MaxStaticForkPct);
+  limits.cpForks = limit(forks, MaxStaticCPForkPct);
+  limits.solverTime = limit(solverTime, MaxStaticSolvePct);
+  limits.cpSolverTime = limit(solverTime, MaxStaticCPSolvePct);
+  limits.nextForks = forks + forks / StaticPctLimitsStep + 1;
+  limits.nextSolverTime = solverTime + solverTime / StaticPctLimitsStep + 1;
+}
+
 ref<Expr> Executor::maxStaticPctChecks(ExecutionState &current,
                                        ref<Expr> condition) {
   if (isa<klee::ConstantExpr>(condition))
@@ -1005,32 +1236,23 @@ ref<Expr> Executor::maxStaticPctChecks(ExecutionState &current,
       MaxStaticCPForkPct == 1. && MaxStaticCPSolvePct == 1.)
     return condition;
 
-  // These checks are performed only after at least MaxStaticPctCheckDelay forks
-  // have been performed since execution started
-  if (stats::forks < MaxStaticPctCheckDelay)
-    return condition;
+  const StaticPctLimits &limits = staticPctLimits;
+  if (stats::forks >= limits.nextForks ||
+      stats::solverTime >= limits.nextSolverTime)
+    updateStaticPctLimits();
 
-  StatisticManager &sm = *theStatisticManager;
+  const KInstruction *ki = current.prevPC;
   CallPathNode *cpn = current.stack.back().callPathNode;
 
-  bool reached_max_fork_limit =
-      (MaxStaticForkPct < 1. &&
-       (sm.getIndexedValue(stats::forks, sm.getIndex()) >
-        stats::forks * MaxStaticForkPct));
+  bool reached_max_fork_limit = ki->forks > limits.forks;
 
-  bool reached_max_cp_fork_limit = (MaxStaticCPForkPct < 1. && cpn &&
-                                    (cpn->statistics.getValue(stats::forks) >
-                                     stats::forks * MaxStaticCPForkPct));
+  bool reached_max_cp_fork_limit =
+      cpn && cpn->statistics.getValue(stats::forks) > limits.cpForks;
 
-  bool reached_max_solver_limit =
-      (MaxStaticSolvePct < 1 &&
-       (sm.getIndexedValue(stats::solverTime, sm.getIndex()) >
-        stats::solverTime * MaxStaticSolvePct));
+  bool reached_max_solver_limit = ki->solverTime > limits.solverTime;
 
   bool reached_max_cp_solver_limit =
-      (MaxStaticCPForkPct < 1. && cpn &&
-       (cpn->statistics.getValue(stats::solverTime) >
-        stats::solverTime * MaxStaticCPSolvePct));
+      cpn && cpn->statistics.getValue(stats::solverTime) > limits.cpSolverTime;
 
   if (reached_max_fork_limit || reached_max_cp_fork_limit ||
       reached_max_solver_limit || reached_max_cp_solver_limit) {
@@ -1052,6 +1274,51 @@ ref<Expr> Executor::maxStaticPctChecks(ExecutionState &current,
   return condition;
 }
 
+time::Span Executor::getSolverTimeout() const {
+  // Queries timed before the timeout is derived from their distribution
+  const std::uint64_t minTimedQueries = 100;
+  // Below this, process and solver start-up dominates the query time
+  const time::Span minTimeout = time::milliseconds(10);
+
+  if (!AdaptiveSolverTimeout || queryTimes.size() < minTimedQueries)
+    return coreSolverTimeout;
+  time::Span timeout =
+      queryTimes.getQuantile(0.99) * AdaptiveSolverTimeoutFactor.getValue();
+  if (timeout < minTimeout)
+    timeout = minTimeout;
+  if (coreSolverTimeout && coreSolverTimeout < timeout)
+    timeout = coreSolverTimeout;
+  return timeout;
+}
+
+bool Executor::followsSeedOnTimeout(const ExecutionState &state) const {
+  return SeedTimeoutFallback &&
+         seedMap.count(const_cast<ExecutionState *>(&state));
+}
+
+ref<klee::ConstantExpr> Executor::getSeedValue(const ExecutionState &state,
+                                               ref<Expr> e) {
+  Assignment assignment;
+  auto it = seedMap.find(const_cast<ExecutionState *>(&state));
+  if (it != seedMap.end() && !it->second.empty())
+    assignment.bindings = it->second.front().assignment.bindings;
+  return cast<ConstantExpr>(assignment.evaluate(e));
+}
+
+void Executor::logDroppedConstraint(const ExecutionState &state,
+                                    ref<Expr> condition) {
+  ++stats::droppedConstraints;
+  std::string sourceLoc = state.prevPC->getSourceLocation();
+  klee_warning_once(state.prevPC, "solver timed out, following the seed at %s",
+                    sourceLoc.c_str());
+  if (LogPPC) {
+    std::string log_message;
+    llvm::raw_string_ostream os(log_message);
+    os << "\n[path:ppc:dropped] " << sourceLoc << " : " << condition;
+    EventLog::log(EventKind::PPC, state.getID(), std::move(os.str()));
+  }
+}
+
 Executor::StatePair Executor::fork(ExecutionState &current, ref<Expr> condition,
                                    bool isInternal, BranchType reason) {
   Solver::Validity res;
@@ -1059,24 +1326,41 @@ Executor::StatePair Executor::fork(ExecutionState &current, ref<Expr> condition,
     seedMap.find(&current);
   bool isSeeding = it != seedMap.end();
 
+  if (dependencyIndex && !isInternal && !isa<ConstantExpr>(condition))
+    recordDependencies(current, condition);
+
   if (!isSeeding)
     condition = maxStaticPctChecks(current, condition);
 
-  time::Span timeout = coreSolverTimeout;
+  time::Span timeout = getSolverTimeout();
   if (isSeeding)
     timeout *= static_cast<unsigned>(it->second.size());
   solver->setTimeout(timeout);
   bool success;
   if (usingSeeds) {
-    ref<Expr> clone_cond = cloneTree(condition);
-    ref<Expr> conc_cond = concretizeExpr(current, clone_cond);
-    success = solver->evaluate(current.constraints, conc_cond, res,
-                               current.queryMetaData);
-    if (!(dyn_cast<ConstantExpr>(condition))) {
-      if (res == Solver::True)
-        addConstraint(current, condition);
-      else
-        addConstraint(current, Expr::createIsZero(condition));
+    if (!isInternal && !isa<ConstantExpr>(condition) &&
+        followSeedPrefix(current, res)) {
+      success = true;
+    } else {
+      ref<Expr> clone_cond = cloneTree(condition);
+      ref<Expr> conc_cond = concretizeExpr(current, clone_cond);
+      success = solver->evaluate(current.constraints, conc_cond, res,
+                                 current.queryMetaData);
+    }
+    if (!success && followsSeedOnTimeout(current)) {
+      // Losing the only path of a concolic run costs more than one
+      // unsolved branch, follow the seed without constraining the path
+      bool seedTrue = getSeedValue(current, condition)->isTrue();
+      res = seedTrue ? Solver::True : Solver::False;
+      logDroppedConstraint(current, seedTrue ? condition
+                                             : Expr::createIsZero(condition));
+      success = true;
+    } else if (success && !isa<ConstantExpr>(condition)) {
+      ref<Expr> taken = res == Solver::True ? condition
+                                            : Expr::createIsZero(condition);
+      if ((concolicCampaign || FlipBranches) && !isInternal)
+        recordConcolicBranch(current, taken, res == Solver::True);
+      addConstraint(current, taken);
     }
   } else {
     success = solver->evaluate(current.constraints, condition, res,
@@ -1185,6 +1469,7 @@ Executor::StatePair Executor::fork(ExecutionState &current, ref<Expr> condition,
     ExecutionState *falseState, *trueState = &current;
 
     ++stats::forks;
+    ++current.prevPC->forks;
 
     falseState = trueState->branch();
     addedStates.push_back(falseState);
@@ -1275,8 +1560,11 @@ void Executor::addConstraint(ExecutionState &state, ref<Expr> condition) {
       bool success = solver->mustBeFalse(state.constraints,
                                          siit->assignment.evaluate(condition),
                                          res, state.queryMetaData);
-      assert(success && "FIXME: Unhandled solver failure");
-      (void) success;
+      if (!success) {
+        // The check only warns, a timeout must not stop the seed
+        assert(SeedTimeoutFallback && "FIXME: Unhandled solver failure");
+        continue;
+      }
       if (res) {
         warn = true;
       }
@@ -1286,8 +1574,11 @@ void Executor::addConstraint(ExecutionState &state, ref<Expr> condition) {
   }
 
   std::string sourceLoc = state.prevPC->getSourceLocation();
-  if (sourceLoc.find("_check.c") == std::string::npos)
+  if (sourceLoc.find("_check.c") == std::string::npos) {
     state.addConstraint(condition);
+    if ((concolicCampaign || FlipBranches) && usingSeeds)
+      state.concolicConstraints.push_back(condition);
+  }
   if (PrintPath) {
     std::string constraints;
     getConstraintLog(state, constraints, Interpreter::SMTLIB2);
@@ -1302,12 +1593,12 @@ void Executor::addConstraint(ExecutionState &state, ref<Expr> condition) {
 
     if (sourceLoc.find("klee") == std::string::npos) {
         std::string log_message = "\n[path:ppc] " + sourceLoc + " : " + constraints;
-        klee_log_ppc("%s", log_message.c_str());
+        EventLog::log(EventKind::PPC, state.getID(), std::move(log_message));
     }
   }
   if (LogTrace && !TraceFilter.empty() && TraceFilter == "control-loc") {
     std::string log_message = "\n[klee:trace] " + state.prevPC->getSourceLocation();
-    klee_log_trace("%s", log_message.c_str());
+    EventLog::log(EventKind::Trace, state.getID(), std::move(log_message));
   }
   if (ivcEnabled)
     doImpliedValueConcretization(state, condition, 
@@ -1335,8 +1626,14 @@ const Cell& Executor::eval(KInstruction *ki, unsigned index,
 
 void Executor::bindLocal(KInstruction *target, ExecutionState &state, 
                          ref<Expr> value) {
-  specialFunctionHandler->trackTaint(state, target, value);
-  getDestCell(state, target).value = value;
+  Cell &cell = getDestCell(state, target);
+  if (taintTracker)
+    cell.taint = getInstructionTaint(target, state);
+  else
+    specialFunctionHandler->trackTaint(state, target, value);
+  cell.value = value;
+  if (exprProfiler)
+    exprProfiler->record(target, value);
 }
 
 void Executor::bindArgument(KFunction *kf, unsigned index, 
@@ -1354,7 +1651,7 @@ ref<Expr> Executor::toUnique(const ExecutionState &state,
     ref<ConstantExpr> value;
     bool isTrue = false;
     e = optimizer.optimizeExpr(e, true);
-    solver->setTimeout(coreSolverTimeout);
+    solver->setTimeout(getSolverTimeout());
     if (solver->getValue(state.constraints, e, value, state.queryMetaData)) {
       ref<Expr> cond = EqExpr::create(e, value);
       cond = optimizer.optimizeExpr(cond, false);
@@ -1519,6 +1816,129 @@ static inline const llvm::fltSemantics *fpWidthToSemantics(unsigned width) {
   }
 }
 
+bool Executor::executeSymbolicFP(ExecutionState &state, KInstruction *ki) {
+  Instruction *i = ki->inst;
+  bool binary = isa<BinaryOperator>(i) || isa<FCmpInst>(i);
+  ref<Expr> left = eval(ki, 0, state).value;
+  ref<Expr> right = binary ? eval(ki, 1, state).value : ref<Expr>();
+  if (isa<ConstantExpr>(left) && (!right || isa<ConstantExpr>(right)))
+    return false;
+
+  // Only IEEE single and double precision have a solver lowering, x87 long
+  // double stays concretized.
+  Expr::Width resultWidth = getWidthForLLVMType(i->getType());
+  bool fpOperands = !isa<SIToFPInst>(i) && !isa<UIToFPInst>(i);
+  bool fpResult =
+      !isa<FPToSIInst>(i) && !isa<FPToUIInst>(i) && !isa<FCmpInst>(i);
+  if ((fpOperands && !ConstantExpr::isFloatingPointWidth(left->getWidth())) ||
+      (fpResult && !ConstantExpr::isFloatingPointWidth(resultWidth)))
+    return false;
+
+  ref<Expr> result;
+  switch (i->getOpcode()) {
+  case Instruction::FNeg:
+    result = XorExpr::create(
+        left, ConstantExpr::alloc(APInt::getSignMask(left->getWidth())));
+    break;
+  case Instruction::FAdd:
+    result = FAddExpr::create(left, right);
+    break;
+  case Instruction::FSub:
+    result = FSubExpr::create(left, right);
+    break;
+  case Instruction::FMul:
+    result = FMulExpr::create(left, right);
+    break;
+  case Instruction::FDiv:
+    result = FDivExpr::create(left, right);
+    break;
+  case Instruction::FPTrunc:
+  case Instruction::FPExt:
+    result = FPConvertExpr::create(left, resultWidth);
+    break;
+  case Instruction::FPToSI:
+    result = FPToSIExpr::create(left, resultWidth);
+    break;
+  case Instruction::FPToUI:
+    result = FPToUIExpr::create(left, resultWidth);
+    break;
+  case Instruction::SIToFP:
+    result = SIToFPExpr::create(left, resultWidth);
+    break;
+  case Instruction::UIToFP:
+    result = UIToFPExpr::create(left, resultWidth);
+    break;
+  case Instruction::FCmp: {
+    // Only ordered comparisons exist as expressions: a value is ordered iff
+    // it compares equal to itself, and an unordered predicate is the
+    // negation of the opposite ordered one.
+    ref<Expr> ordered = AndExpr::create(FOEqExpr::create(left, left),
+                                        FOEqExpr::create(right, right));
+    switch (cast<FCmpInst>(i)->getPredicate()) {
+    case FCmpInst::FCMP_FALSE:
+      result = ConstantExpr::alloc(0, Expr::Bool);
+      break;
+    case FCmpInst::FCMP_TRUE:
+      result = ConstantExpr::alloc(1, Expr::Bool);
+      break;
+    case FCmpInst::FCMP_ORD:
+      result = ordered;
+      break;
+    case FCmpInst::FCMP_UNO:
+      result = Expr::createIsZero(ordered);
+      break;
+    case FCmpInst::FCMP_OEQ:
+      result = FOEqExpr::create(left, right);
+      break;
+    case FCmpInst::FCMP_ONE:
+      result = AndExpr::create(
+          ordered, Expr::createIsZero(FOEqExpr::create(left, right)));
+      break;
+    case FCmpInst::FCMP_OGT:
+      result = FOLtExpr::create(right, left);
+      break;
+    case FCmpInst::FCMP_OGE:
+      result = FOLeExpr::create(right, left);
+      break;
+    case FCmpInst::FCMP_OLT:
+      result = FOLtExpr::create(left, right);
+      break;
+    case FCmpInst::FCMP_OLE:
+      result = FOLeExpr::create(left, right);
+      break;
+    case FCmpInst::FCMP_UEQ:
+      result = Expr::createIsZero(AndExpr::create(
+          ordered, Expr::createIsZero(FOEqExpr::create(left, right))));
+      break;
+    case FCmpInst::FCMP_UNE:
+      result = Expr::createIsZero(FOEqExpr::create(left, right));
+      break;
+    case FCmpInst::FCMP_UGT:
+      result = Expr::createIsZero(FOLeExpr::create(left, right));
+      break;
+    case FCmpInst::FCMP_UGE:
+      result = Expr::createIsZero(FOLtExpr::create(left, right));
+      break;
+    case FCmpInst::FCMP_ULT:
+      result = Expr::createIsZero(FOLeExpr::create(right, left));
+      break;
+    case FCmpInst::FCMP_ULE:
+      result = Expr::createIsZero(FOLtExpr::create(right, left));
+      break;
+    default:
+      return false;
+    }
+    break;
+  }
+  default:
+    // FRem has no solver lowering and stays concretized
+    return false;
+  }
+
+  bindLocal(ki, state, result);
+  return true;
+}
+
 MemoryObject *Executor::serializeLandingpad(ExecutionState &state,
                                             const llvm::LandingPadInst &lpi,
                                             bool &stateTerminated) {
@@ -1747,11 +2167,45 @@ ref<klee::ConstantExpr> Executor::getEhTypeidFor(ref<Expr> type_info) {
   return res;
 }
 
+bool Executor::isProvenCheck(ExecutionState &state, Function *f,
+                             const std::vector<ref<Expr>> &arguments) {
+  ref<Expr> condition;
+  if (f == divZeroCheckFunction && arguments.size() == 1)
+    condition = Expr::createIsZero(Expr::createIsZero(arguments[0]));
+  else if (f == overshiftCheckFunction && arguments.size() == 2)
+    condition = UltExpr::create(arguments[1], arguments[0]);
+  else
+    return false;
+
+  if (auto ce = dyn_cast<ConstantExpr>(condition))
+    return ce->isTrue();
+
+  // A condition that holds without any path constraint holds on every path,
+  // so each symbolic condition is only queried once
+  auto it = provenChecks.find(condition);
+  if (it != provenChecks.end())
+    return it->second;
+  bool proven = false;
+  solver->setTimeout(getSolverTimeout());
+  if (!solver->mustBeTrue(ConstraintSet(), condition, proven,
+                          state.queryMetaData))
+    proven = false;
+  solver->setTimeout(time::Span());
+  provenChecks.insert(std::make_pair(condition, proven));
+  return proven;
+}
+
 void Executor::executeCall(ExecutionState &state, KInstruction *ki, Function *f,
                            std::vector<ref<Expr>> &arguments) {
   Instruction *i = ki->inst;
   if (isa_and_nonnull<DbgInfoIntrinsic>(i))
     return;
+  if (f && (f == divZeroCheckFunction || f == overshiftCheckFunction) &&
+      isProvenCheck(state, f, arguments))
+    return;
+  if (f && !outputOnlyFunctions.empty() && isa<CallInst>(i) &&
+      i->use_empty() && outputOnlyFunctions.count(f))
+    return;
   if (f && f->isDeclaration()) {
     switch (f->getIntrinsicID()) {
     case Intrinsic::not_intrinsic: {
@@ -1971,6 +2425,10 @@ void Executor::executeCall(ExecutionState &state, KInstruction *ki, Function *f,
       transferToBasicBlock(ii->getNormalDest(), i->getParent(), state);
     }
   } else {
+    if (!nativeFunctions.empty() && nativeFunctions.count(f) &&
+        callNativeFunction(state, ki, kmodule->functionMap[f], arguments))
+      return;
+
     // Check if maximum stack size was reached.
     // We currently only count the number of stack frames
     if (RuntimeMaxStackFrames && state.stack.size() > RuntimeMaxStackFrames) {
@@ -2101,6 +2559,12 @@ void Executor::executeCall(ExecutionState &state, KInstruction *ki, Function *f,
     unsigned numFormals = f->arg_size();
     for (unsigned k = 0; k < numFormals; k++)
       bindArgument(kf, k, state, arguments[k]);
+
+    if (taintTracker) {
+      const StackFrame &caller = state.stack[state.stack.size() - 2];
+      for (unsigned k = 0; k < numFormals; k++)
+        getArgumentCell(state, kf, k).taint = getOperandTaint(ki, k + 1, caller);
+    }
   }
 }
 
@@ -2126,6 +2590,19 @@ void Executor::transferToBasicBlock(BasicBlock *dst, BasicBlock *src,
     PHINode *first = static_cast<PHINode*>(state.pc->inst);
     state.incomingBBIndex = first->getBasicBlockIndex(src);
   }
+
+  if (state.edgeCoverage) {
+    std::uint32_t context = 0;
+    if (interpreterOpts.CoverageMapContext && state.stack.back().callPathNode)
+      context = state.stack.back().callPathNode->contextHash;
+    // Copy a map shared with other states before adding to it
+    if (state.edgeCoverage.use_count() > 1)
+      state.edgeCoverage = std::make_shared<CoverageMap>(*state.edgeCoverage);
+    // Unlike InstructionInfo ids, assembly lines are the same in every run,
+    // so maps of different runs can be merged
+    state.edgeCoverage->addEdge(state.prevPC->info->assemblyLine,
+                                state.pc->info->assemblyLine, context);
+  }
 }
 
 /// Compute the true target of a function call, resolving LLVM aliases
@@ -2170,17 +2647,19 @@ void Executor::executeInstruction(ExecutionState &state, KInstruction *ki) {
       if (!TraceFilter.empty()) {
         if (sourceLoc.find(TraceFilter, 0) == std::string::npos) {
           std::string log_message = "\n[klee:trace] " + sourceLoc;
-          klee_log_trace("%s", log_message.c_str());
+          EventLog::log(EventKind::Trace, state.getID(),
+                        std::move(log_message));
         }
       } else if(!LocHit.empty()){
         if(std::find(hit_list.begin(), hit_list.end(), sourceLoc) != hit_list.end()){
           std::string log_message = "\n[klee:trace] " + sourceLoc;
-          klee_log_trace("%s", log_message.c_str());
+          EventLog::log(EventKind::Trace, state.getID(),
+                        std::move(log_message));
           hit_list.erase(sourceLoc);
         }
       } else {
         std::string log_message = "\n[klee:trace] " + sourceLoc;
-        klee_log_trace("%s", log_message.c_str());
+        EventLog::log(EventKind::Trace, state.getID(), std::move(log_message));
       }
     }
 
@@ -2188,6 +2667,9 @@ void Executor::executeInstruction(ExecutionState &state, KInstruction *ki) {
       errs() << "\n[LLVM] " << *(ki->inst) << "\n";
   }
 
+  if (taintTracker)
+    taintTracker->reach(ki, getInstructionTaint(ki, state));
+
   switch (i->getOpcode()) {
     // Control flow
   case Instruction::Ret: {
@@ -2196,11 +2678,14 @@ void Executor::executeInstruction(ExecutionState &state, KInstruction *ki) {
     Instruction *caller = kcaller ? kcaller->inst : nullptr;
     bool isVoidReturn = (ri->getNumOperands() == 0);
     ref<Expr> result = ConstantExpr::alloc(0, Expr::Bool);
+    TaintSet resultTaint = 0;
     
     if (!isVoidReturn) {
-      result = eval(ki, 0, state).value;
+      const Cell &cell = eval(ki, 0, state);
+      result = cell.value;
+      resultTaint = cell.taint;
     }
-    
+
     if (state.stack.size() <= 1) {
       assert(!caller && "caller set on initial stack frame");
       terminateStateOnExit(state);
@@ -2275,6 +2760,8 @@ void Executor::executeInstruction(ExecutionState &state, KInstruction *ki) {
           }
 
           bindLocal(kcaller, state, result);
+          if (taintTracker)
+            getDestCell(state, kcaller).taint = resultTaint;
         }
       } else {
         // We check that the return value has no users instead of
@@ -2674,6 +3161,8 @@ void Executor::executeInstruction(ExecutionState &state, KInstruction *ki) {
   case Instruction::UDiv: {
     ref<Expr> left = eval(ki, 0, state).value;
     ref<Expr> right = eval(ki, 1, state).value;
+    if (Zesti && !isa<ConstantExpr>(right))
+      recordSensitiveOperation(state);
     ref<Expr> result = UDivExpr::create(left, right);
     bindLocal(ki, state, result);
     break;
@@ -2682,6 +3171,8 @@ void Executor::executeInstruction(ExecutionState &state, KInstruction *ki) {
   case Instruction::SDiv: {
     ref<Expr> left = eval(ki, 0, state).value;
     ref<Expr> right = eval(ki, 1, state).value;
+    if (Zesti && !isa<ConstantExpr>(right))
+      recordSensitiveOperation(state);
     ref<Expr> result = SDivExpr::create(left, right);
     bindLocal(ki, state, result);
     break;
@@ -2690,6 +3181,8 @@ void Executor::executeInstruction(ExecutionState &state, KInstruction *ki) {
   case Instruction::URem: {
     ref<Expr> left = eval(ki, 0, state).value;
     ref<Expr> right = eval(ki, 1, state).value;
+    if (Zesti && !isa<ConstantExpr>(right))
+      recordSensitiveOperation(state);
     ref<Expr> result = URemExpr::create(left, right);
     bindLocal(ki, state, result);
     break;
@@ -2698,6 +3191,8 @@ void Executor::executeInstruction(ExecutionState &state, KInstruction *ki) {
   case Instruction::SRem: {
     ref<Expr> left = eval(ki, 0, state).value;
     ref<Expr> right = eval(ki, 1, state).value;
+    if (Zesti && !isa<ConstantExpr>(right))
+      recordSensitiveOperation(state);
     ref<Expr> result = SRemExpr::create(left, right);
     bindLocal(ki, state, result);
     break;
@@ -2867,7 +3362,8 @@ void Executor::executeInstruction(ExecutionState &state, KInstruction *ki) {
   case Instruction::Store: {
     ref<Expr> base = eval(ki, 1, state).value;
     ref<Expr> value = eval(ki, 0, state).value;
-    specialFunctionHandler->trackTaint(state, ki, value);
+    if (!taintTracker)
+      specialFunctionHandler->trackTaint(state, ki, value);
     executeMemoryOperation(state, true, base, value, 0);
     break;
   }
@@ -2939,6 +3435,8 @@ void Executor::executeInstruction(ExecutionState &state, KInstruction *ki) {
 
     // Floating point instructions
   case Instruction::FNeg: {
+    if (SymbolicFP && executeSymbolicFP(state, ki))
+      break;
     ref<ConstantExpr> arg =
         toConstant(state, eval(ki, 0, state).value, "floating point");
     if (!fpWidthToSemantics(arg->getWidth()))
@@ -2951,6 +3449,8 @@ void Executor::executeInstruction(ExecutionState &state, KInstruction *ki) {
   }
 
   case Instruction::FAdd: {
+    if (SymbolicFP && executeSymbolicFP(state, ki))
+      break;
     ref<ConstantExpr> left = toConstant(state, eval(ki, 0, state).value,
                                         "floating point");
     ref<ConstantExpr> right = toConstant(state, eval(ki, 1, state).value,
@@ -2966,6 +3466,8 @@ void Executor::executeInstruction(ExecutionState &state, KInstruction *ki) {
   }
 
   case Instruction::FSub: {
+    if (SymbolicFP && executeSymbolicFP(state, ki))
+      break;
     ref<ConstantExpr> left = toConstant(state, eval(ki, 0, state).value,
                                         "floating point");
     ref<ConstantExpr> right = toConstant(state, eval(ki, 1, state).value,
@@ -2980,6 +3482,8 @@ void Executor::executeInstruction(ExecutionState &state, KInstruction *ki) {
   }
 
   case Instruction::FMul: {
+    if (SymbolicFP && executeSymbolicFP(state, ki))
+      break;
     ref<ConstantExpr> left = toConstant(state, eval(ki, 0, state).value,
                                         "floating point");
     ref<ConstantExpr> right = toConstant(state, eval(ki, 1, state).value,
@@ -2995,6 +3499,8 @@ void Executor::executeInstruction(ExecutionState &state, KInstruction *ki) {
   }
 
   case Instruction::FDiv: {
+    if (SymbolicFP && executeSymbolicFP(state, ki))
+      break;
     ref<ConstantExpr> left = toConstant(state, eval(ki, 0, state).value,
                                         "floating point");
     ref<ConstantExpr> right = toConstant(state, eval(ki, 1, state).value,
@@ -3025,6 +3531,8 @@ void Executor::executeInstruction(ExecutionState &state, KInstruction *ki) {
   }
 
   case Instruction::FPTrunc: {
+    if (SymbolicFP && executeSymbolicFP(state, ki))
+      break;
     FPTruncInst *fi = cast<FPTruncInst>(i);
     Expr::Width resultType = getWidthForLLVMType(fi->getType());
     ref<ConstantExpr> arg = toConstant(state, eval(ki, 0, state).value,
@@ -3042,6 +3550,8 @@ void Executor::executeInstruction(ExecutionState &state, KInstruction *ki) {
   }
 
   case Instruction::FPExt: {
+    if (SymbolicFP && executeSymbolicFP(state, ki))
+      break;
     FPExtInst *fi = cast<FPExtInst>(i);
     Expr::Width resultType = getWidthForLLVMType(fi->getType());
     ref<ConstantExpr> arg = toConstant(state, eval(ki, 0, state).value,
@@ -3058,6 +3568,8 @@ void Executor::executeInstruction(ExecutionState &state, KInstruction *ki) {
   }
 
   case Instruction::FPToUI: {
+    if (SymbolicFP && executeSymbolicFP(state, ki))
+      break;
     FPToUIInst *fi = cast<FPToUIInst>(i);
     Expr::Width resultType = getWidthForLLVMType(fi->getType());
     ref<ConstantExpr> arg = toConstant(state, eval(ki, 0, state).value,
@@ -3076,6 +3588,8 @@ void Executor::executeInstruction(ExecutionState &state, KInstruction *ki) {
   }
 
   case Instruction::FPToSI: {
+    if (SymbolicFP && executeSymbolicFP(state, ki))
+      break;
     FPToSIInst *fi = cast<FPToSIInst>(i);
     Expr::Width resultType = getWidthForLLVMType(fi->getType());
     ref<ConstantExpr> arg = toConstant(state, eval(ki, 0, state).value,
@@ -3094,6 +3608,8 @@ void Executor::executeInstruction(ExecutionState &state, KInstruction *ki) {
   }
 
   case Instruction::UIToFP: {
+    if (SymbolicFP && executeSymbolicFP(state, ki))
+      break;
     UIToFPInst *fi = cast<UIToFPInst>(i);
     Expr::Width resultType = getWidthForLLVMType(fi->getType());
     ref<ConstantExpr> arg = toConstant(state, eval(ki, 0, state).value,
@@ -3110,6 +3626,8 @@ void Executor::executeInstruction(ExecutionState &state, KInstruction *ki) {
   }
 
   case Instruction::SIToFP: {
+    if (SymbolicFP && executeSymbolicFP(state, ki))
+      break;
     SIToFPInst *fi = cast<SIToFPInst>(i);
     Expr::Width resultType = getWidthForLLVMType(fi->getType());
     ref<ConstantExpr> arg = toConstant(state, eval(ki, 0, state).value,
@@ -3126,6 +3644,8 @@ void Executor::executeInstruction(ExecutionState &state, KInstruction *ki) {
   }
 
   case Instruction::FCmp: {
+    if (SymbolicFP && executeSymbolicFP(state, ki))
+      break;
     FCmpInst *fi = cast<FCmpInst>(i);
     ref<ConstantExpr> left = toConstant(state, eval(ki, 0, state).value,
                                         "floating point");
@@ -3537,7 +4057,8 @@ bool Executor::checkMemoryUsage() {
   // check memory limit
   const auto mallocUsage = util::GetTotalMallocUsage() >> 20U;
   const auto mmapUsage = memory->getUsedDeterministicSize() >> 20U;
-  const auto totalUsage = mallocUsage + mmapUsage;
+  const auto totalUsage =
+      ReplayLog::sync(ReplayEventKind::MemoryUsage, mallocUsage + mmapUsage);
   atMemoryLimit = totalUsage > MaxMemory; // inhibit forking
   if (!atMemoryLimit)
     return true;
@@ -3584,6 +4105,8 @@ void Executor::run(ExecutionState &initialState) {
 
   // Delay init till now so that ticks don't accrue during optimization and such.
   timers.reset();
+  // Each run of a concolic campaign times out against its own queries
+  queryTimes.clear();
 
   states.insert(&initialState);
 
@@ -3601,9 +4124,39 @@ void Executor::run(ExecutionState &initialState) {
     LocHit = "ACTIVE";
   }
 
+  if (SkipOutputCalls) {
+    std::set<const Function *> keep;
+    for (const auto &kf : kmodule->functions)
+      for (unsigned i = 0; i < kf->numInstructions && !hit_list.empty(); ++i)
+        if (hit_list.count(kf->instructions[i]->getSourceLocation())) {
+          keep.insert(kf->function);
+          break;
+        }
+    outputOnlyFunctions = getOutputOnlyFunctions(*kmodule->module, keep);
+    klee_message("skipping the calls to %zu output-only functions",
+                 outputOnlyFunctions.size());
+  }
+
   if (usingSeeds) {
     std::vector<SeedInfo> &v = seedMap[&initialState];
 
+    if (!seedPrefix.empty() && usingSeeds->size() != 1) {
+      klee_warning("ignoring the seed prefix, it requires a single seed");
+      seedPrefix.clear();
+    }
+
+    // A concolic campaign runs with a new seed each time, drop the values
+    // of the previous run
+    free(a_data);
+    free(a_data_stat);
+    a_data = a_data_stat = nullptr;
+    for (auto &var : var_map)
+      free(var.second);
+    for (auto &arg : arg_map)
+      free(arg.second);
+    var_map.clear();
+    arg_map.clear();
+
     for (std::vector<KTest*>::const_iterator it = usingSeeds->begin(), 
            ie = usingSeeds->end(); it != ie; ++it) {
       v.push_back(SeedInfo(*it));
@@ -3662,7 +4215,10 @@ void Executor::run(ExecutionState &initialState) {
       KInstruction *ki = state.pc;
       stepInstruction(state);
 
+      time::Span queryCost = state.queryMetaData.queryCost;
       executeInstruction(state, ki);
+      ki->solverTime +=
+          (state.queryMetaData.queryCost - queryCost).toMicroseconds();
       timers.invoke();
       if (::dumpStates) dumpStates();
       if (::dumpPTree) dumpPTree();
@@ -3711,7 +4267,10 @@ void Executor::run(ExecutionState &initialState) {
     KInstruction *ki = state.pc;
     stepInstruction(state);
 
+    time::Span queryCost = state.queryMetaData.queryCost;
     executeInstruction(state, ki);
+    ki->solverTime +=
+        (state.queryMetaData.queryCost - queryCost).toMicroseconds();
     timers.invoke();
     if (::dumpStates) dumpStates();
     if (::dumpPTree) dumpPTree();
@@ -3785,6 +4344,17 @@ std::string Executor::getAddressInfo(ExecutionState &state,
 
 
 void Executor::terminateState(ExecutionState &state) {
+  if (concolicCampaign || FlipBranches) {
+    auto seeds = seedMap.find(&state);
+    if (seeds != seedMap.end() && !seeds->second.empty()) {
+      const KTest *seed = seeds->second.front().input;
+      if (FlipBranches)
+        writeFlippedSeeds(state, seed);
+      if (concolicCampaign)
+        concolicCampaign->addPath(state, seed);
+    }
+  }
+
   if (replayKTest && replayPosition!=replayKTest->numObjects) {
     klee_warning_once(replayKTest,
                       "replay did not consume all objects in test input.");
@@ -4012,7 +4582,8 @@ ref<Expr> Executor::concretizeReadExpr(const ExecutionState &state,
     if (name_src == "A-data") {
       int value = a_data[index];
         std::string log_message = "\n[concretizing] A-data[" + str_index + "] \n";
-        klee_log_concrete("%s", log_message.c_str());
+        EventLog::log(EventKind::Concrete, state.getID(),
+                      std::move(log_message));
       resolve = ConstantExpr::create(value, width);
       modified = true;
     } else if (name_src == "A-data-stat") {
@@ -4036,6 +4607,11 @@ ref<Expr> Executor::concretizeReadExpr(const ExecutionState &state,
 
         bool success = solver->getValue(state.constraints, ce, resolve,
                                         state.queryMetaData);
+        if (!success && followsSeedOnTimeout(state)) {
+          resolve = getSeedValue(state, ce);
+          logDroppedConstraint(state, EqExpr::create(ce, resolve));
+          success = true;
+        }
         assert(success && "FIXME: Unhandled solver failure");
         (void)success;
         modified = true;
@@ -4084,6 +4660,11 @@ ref<Expr> Executor::concretizeExpr(const klee::ExecutionState &state,
 
   bool success = solver->getValue(state.constraints, expr, resolve,
                                   state.queryMetaData);
+  if (!success && followsSeedOnTimeout(state)) {
+    resolve = getSeedValue(state, expr);
+    logDroppedConstraint(state, EqExpr::create(expr, resolve));
+    success = true;
+  }
   assert(success && "FIXME: Unhandled solver failure");
   (void)success;
 
@@ -4206,11 +4787,44 @@ void Executor::callExternalFunction(ExecutionState &state,
       return;
   }
 
-  if (usingSeeds)
-    for (std::vector<ref<Expr>>::iterator ai = arguments.begin(),
-                                          ae = arguments.end();
-         ai != ae; ++ai)
-      *ai = concretizeExpr(state, *ai);
+  // External calls in loops often repeat their symbolic arguments: reuse
+  // their values on the path, and evaluate them on the seed before asking
+  // the solver. A seed's values are fixed along its path, so values taken
+  // from the seed are only cached while the state follows a single seed; in
+  // seeded mode the arguments are not constrained, so branches on them can
+  // still be flipped.
+  auto seeds = seedMap.find(&state);
+  bool singleSeed = seeds != seedMap.end() && seeds->second.size() == 1;
+  bool useCache = !usingSeeds || singleSeed;
+  for (auto &arg : arguments) {
+    if (isa<ConstantExpr>(arg))
+      continue;
+    if (useCache) {
+      if (auto cached = state.externalArgumentValues.lookup(arg)) {
+        arg = cached->second;
+        continue;
+      }
+    }
+    ref<Expr> value = arg;
+    if (usingSeeds) {
+      if (seeds != seedMap.end() && !seeds->second.empty())
+        value = seeds->second.front().assignment.evaluate(value);
+      if (!isa<ConstantExpr>(value))
+        value = concretizeExpr(state, value);
+    } else if (ExternalCalls != ExternalCallPolicy::All) {
+      value = toUnique(state, value);
+    }
+    auto ce = dyn_cast<ConstantExpr>(value);
+    if (!ce)
+      continue;
+    // toUnique proved the value, so the equality does not narrow the path
+    if (!usingSeeds)
+      addConstraint(state, EqExpr::create(arg, ce));
+    if (useCache)
+      state.externalArgumentValues =
+          state.externalArgumentValues.replace(std::make_pair(arg, ce));
+    arg = value;
+  }
 
   if (ExternalCalls == ExternalCallPolicy::None &&
       !okExternals.count(callable->getName().str())) {
@@ -4259,6 +4873,18 @@ void Executor::callExternalFunction(ExecutionState &state,
     }
   }
 
+  std::string cacheKey;
+  if (std::find(CacheExternalCalls.begin(), CacheExternalCalls.end(),
+                callable->getName()) != CacheExternalCalls.end() &&
+      getExternalCallKey(state, callable, args, wordIndex, cacheKey)) {
+    auto it = externalCallCache.find(cacheKey);
+    if (it != externalCallCache.end()) {
+      ++stats::cachedExternalCalls;
+      bindCachedExternalCall(state, target, it->second);
+      return;
+    }
+  }
+
   // Prepare external memory for invoking the function
   state.addressSpace.copyOutConcretes();
 #ifndef WINDOWS
@@ -4300,13 +4926,27 @@ void Executor::callExternalFunction(ExecutionState &state,
       klee_warning_once(callable->getValue(), "%s", os.str().c_str());
   }
 
-  bool success = externalDispatcher->executeCall(callable, target->inst, args);
+  bool success;
+  if (ReplayLog::isReplaying()) {
+    success = replayExternalCall(state, target, args);
+  } else {
+    success = externalDispatcher->executeCall(callable, target->inst, args);
+    if (ReplayLog::isRecording())
+      recordExternalCall(state, target, args, success);
+  }
   if (!success) {
     terminateStateOnError(state, "failed external call: " + callable->getName(),
                           StateTerminationType::External);
     return;
   }
 
+  if (!cacheKey.empty() && !state.addressSpace.changedExternally()) {
+    CachedExternalCall &cached = externalCallCache[cacheKey];
+    auto bytes = reinterpret_cast<const std::uint8_t *>(args);
+    cached.result.assign(bytes, bytes + Expr::MaxWidth / 8);
+    cached.error = externalDispatcher->getLastErrno();
+  }
+
   if (!state.addressSpace.copyInConcretes()) {
     terminateStateOnError(state, "external modified read-only object",
                           StateTerminationType::External);
@@ -4328,6 +4968,122 @@ void Executor::callExternalFunction(ExecutionState &state,
   }
 }
 
+bool Executor::callNativeFunction(ExecutionState &state, KInstruction *target,
+                                  KFunction *kf,
+                                  const std::vector<ref<Expr>> &arguments) {
+  auto cb = dyn_cast<CallInst>(target->inst);
+  if (!cb || cb->getFunctionType() != kf->function->getFunctionType())
+    return false;
+
+  // Same argument passing as for external calls
+  size_t allocatedBytes = Expr::MaxWidth / 8 * (arguments.size() + 1);
+  uint64_t *args = (uint64_t *)alloca(allocatedBytes);
+  memset(args, 0, allocatedBytes);
+  unsigned wordIndex = 2;
+  for (const auto &arg : arguments) {
+    auto ce = dyn_cast<ConstantExpr>(arg);
+    if (!ce)
+      return false;
+    // fp80 must be aligned to 16 according to the System V AMD 64 ABI
+    if (ce->getWidth() == Expr::Fl80 && wordIndex & 0x01)
+      wordIndex++;
+    ce->toMemory(&args[wordIndex]);
+    wordIndex += (ce->getWidth() + 63) / 64;
+  }
+
+  // A crash falls back to interpreting the call, which reports the error
+  if (!externalDispatcher->executeNativeCall(kf, target->inst, args))
+    return false;
+
+  ++stats::nativeCalls;
+  bindLocal(target, state,
+            ConstantExpr::fromMemory(
+                (void *)args, getWidthForLLVMType(target->inst->getType())));
+  return true;
+}
+
+bool Executor::getExternalCallKey(const ExecutionState &state,
+                                  KCallable *callable, const uint64_t *args,
+                                  unsigned numWords, std::string &key) {
+  int *errno_addr = getErrnoLocation(state);
+  ObjectPair result;
+  if (!state.addressSpace.resolveOne(
+          ConstantExpr::create((uint64_t)errno_addr, Expr::Int64), result))
+    return false;
+  ref<ConstantExpr> error = dyn_cast<ConstantExpr>(
+      result.second->read(0, sizeof(*errno_addr) * 8));
+  if (!error)
+    return false;
+
+  key = callable->getName().str();
+  key += '\0';
+  std::uint64_t errorValue = error->getZExtValue();
+  key.append(reinterpret_cast<const char *>(&errorValue), sizeof(errorValue));
+  key.append(reinterpret_cast<const char *>(args + 2),
+             (numWords - 2) * sizeof(*args));
+  // The call may read the objects its arguments point to
+  for (unsigned i = 2; i < numWords; ++i) {
+    if (!state.addressSpace.appendConcreteContents(args[i], key)) {
+      key.clear();
+      return false;
+    }
+  }
+  return true;
+}
+
+void Executor::bindCachedExternalCall(ExecutionState &state,
+                                      KInstruction *target,
+                                      const CachedExternalCall &cached) {
+#ifndef WINDOWS
+  int *errno_addr = getErrnoLocation(state);
+  ObjectPair result;
+  if (state.addressSpace.resolveOne(
+          ConstantExpr::create((uint64_t)errno_addr, Expr::Int64), result)) {
+    ObjectState *wos =
+        state.addressSpace.getWriteable(result.first, result.second);
+    wos->write(0, ConstantExpr::create(cached.error, sizeof(int) * 8));
+  }
+#endif
+
+  Type *resultType = target->inst->getType();
+  if (resultType != Type::getVoidTy(kmodule->module->getContext())) {
+    ref<Expr> e = ConstantExpr::fromMemory(
+        const_cast<std::uint8_t *>(cached.result.data()),
+        getWidthForLLVMType(resultType));
+    bindLocal(target, state, e);
+  }
+}
+
+void Executor::recordExternalCall(ExecutionState &state, KInstruction *target,
+                                  uint64_t *args, bool success) {
+  std::vector<std::uint8_t> result;
+  Type *resultType = target->inst->getType();
+  if (success && !resultType->isVoidTy()) {
+    auto bytes = reinterpret_cast<std::uint8_t *>(args);
+    result.assign(bytes, bytes + Expr::getMinBytesForWidth(
+                                     getWidthForLLVMType(resultType)));
+  }
+  std::uint32_t error = externalDispatcher->getLastErrno();
+  ReplayLog::record(ReplayEventKind::ExternalCall,
+                    (std::uint64_t(error) << 1) | success, result);
+  if (success)
+    state.addressSpace.recordExternalChanges();
+}
+
+bool Executor::replayExternalCall(ExecutionState &state, KInstruction *target,
+                                  uint64_t *args) {
+  std::vector<std::uint8_t> result;
+  std::uint64_t outcome =
+      ReplayLog::replay(ReplayEventKind::ExternalCall, &result);
+  memcpy(args, result.data(), result.size());
+  externalDispatcher->setLastErrno(outcome >> 1);
+
+  if (!state.addressSpace.replayExternalChanges())
+    klee_error("replay log has invalid memory changes for the external call "
+               "at %s", target->getSourceLocation().c_str());
+  return outcome & 1;
+}
+
 /***/
 
 ref<Expr> Executor::replaceReadWithSymbolic(ExecutionState &state, 
@@ -4340,7 +5096,7 @@ ref<Expr> Executor::replaceReadWithSymbolic(ExecutionState &state,
   if (!isa<ConstantExpr>(e))
     return e;
 
-  if (n != 1 && random() % n)
+  if (n != 1 && ReplayLog::sync(ReplayEventKind::Random, random()) % n)
     return e;
 
   // create a new fresh location, assert it is equal to concrete value in e
@@ -4571,6 +5327,14 @@ void Executor::resolveExact(ExecutionState &state,
   }
 }
 
+void Executor::executeSeedAddress(ExecutionState &state, bool isWrite,
+                                  ref<Expr> address, ref<Expr> value,
+                                  KInstruction *target) {
+  ref<ConstantExpr> seedAddress = getSeedValue(state, address);
+  logDroppedConstraint(state, EqExpr::create(address, seedAddress));
+  executeMemoryOperation(state, isWrite, seedAddress, value, target);
+}
+
 void Executor::executeMemoryOperation(ExecutionState &state,
                                       bool isWrite,
                                       ref<Expr> address,
@@ -4587,6 +5351,8 @@ void Executor::executeMemoryOperation(ExecutionState &state,
       value = ConstraintManager::simplifyExpr(state.constraints, value);
   }
 
+  if (Zesti && !isa<ConstantExpr>(address))
+    recordSensitiveOperation(state);
   if (!isa<ConstantExpr>(address) && usingSeeds)
     address = concretizeExpr(state, address);
   address = optimizer.optimizeExpr(address, true);
@@ -4594,7 +5360,7 @@ void Executor::executeMemoryOperation(ExecutionState &state,
   // fast path: single in-bounds resolution
   ObjectPair op;
   bool success;
-  solver->setTimeout(coreSolverTimeout);
+  solver->setTimeout(getSolverTimeout());
   if (!state.addressSpace.resolveOne(state, solver, address, op, success)) {
     address = toConstant(state, address, "resolveOne failure");
     success = state.addressSpace.resolveOne(cast<ConstantExpr>(address), op);
@@ -4613,11 +5379,15 @@ void Executor::executeMemoryOperation(ExecutionState &state,
     check = optimizer.optimizeExpr(check, true);
 
     bool inBounds;
-    solver->setTimeout(coreSolverTimeout);
+    solver->setTimeout(getSolverTimeout());
     bool success = solver->mustBeTrue(state.constraints, check, inBounds,
                                       state.queryMetaData);
     solver->setTimeout(time::Span());
     if (!success) {
+      if (followsSeedOnTimeout(state)) {
+        executeSeedAddress(state, isWrite, address, value, target);
+        return;
+      }
       state.pc = state.prevPC;
       terminateStateOnSolverError(state, "Query timed out (bounds check).");
       return;
@@ -4632,6 +5402,13 @@ void Executor::executeMemoryOperation(ExecutionState &state,
         } else {
           ObjectState *wos = state.addressSpace.getWriteable(mo, os);
           wos->write(offset, value);
+          if (taintTracker) {
+            // Only stores carry the taint of their value
+            TaintSet taint = 0;
+            if (isa<StoreInst>(state.prevPC->inst))
+              taint = getOperandTaint(state.prevPC, 0, state.stack.back());
+            setMemoryTaint(wos, offset, bytes, taint);
+          }
           if (state.stack.back().nonLocalsWritten.find(mo) !=
                   state.stack.back().nonLocalsWritten.end() ||
               !llvm::isa<ConstantExpr>(value))
@@ -4643,6 +5420,8 @@ void Executor::executeMemoryOperation(ExecutionState &state,
         if (interpreterOpts.MakeConcreteSymbolic)
           result = replaceReadWithSymbolic(state, result);
         bindLocal(target, state, result);
+        if (taintTracker)
+          getDestCell(state, target).taint = getMemoryTaint(os, offset, bytes);
         if (state.stack.back().nonLocalsRead.find(mo) !=
                 state.stack.back().nonLocalsRead.end() ||
             !llvm::isa<ConstantExpr>(result))
@@ -4658,9 +5437,10 @@ void Executor::executeMemoryOperation(ExecutionState &state,
 
   address = optimizer.optimizeExpr(address, true);
   ResolutionList rl;  
-  solver->setTimeout(coreSolverTimeout);
+  time::Span timeout = getSolverTimeout();
+  solver->setTimeout(timeout);
   bool incomplete = state.addressSpace.resolve(state, solver, address, rl,
-                                               0, coreSolverTimeout);
+                                               0, timeout);
   solver->setTimeout(time::Span());
   
   // XXX there is some query wasteage here. who cares?
@@ -4697,7 +5477,9 @@ void Executor::executeMemoryOperation(ExecutionState &state,
   
   // XXX should we distinguish out of bounds and overlapped cases?
   if (unbound) {
-    if (incomplete) {
+    if (incomplete && followsSeedOnTimeout(*unbound)) {
+      executeSeedAddress(*unbound, isWrite, address, value, target);
+    } else if (incomplete) {
       terminateStateOnSolverError(*unbound, "Query timed out (resolve).");
     } else if (!DisableMemoryCheck) {
       terminateStateOnError(*unbound, "memory error: out of bound pointer",
@@ -4710,6 +5492,11 @@ void Executor::executeMemoryOperation(ExecutionState &state,
 void Executor::executeMakeSymbolic(ExecutionState &state, 
                                    const MemoryObject *mo,
                                    const std::string &name) {
+  if (taintTracker) {
+    executeMakeTainted(state, mo, name);
+    return;
+  }
+
   // Create a new object state for the memory object (instead of a copy).
   if (!replayKTest) {
     // Find a unique name for this array.  First try the original name,
@@ -4781,6 +5568,86 @@ void Executor::executeMakeSymbolic(ExecutionState &state,
   }
 }
 
+void Executor::executeMakeTainted(ExecutionState &state,
+                                  const MemoryObject *mo,
+                                  const std::string &name) {
+  unsigned id = 0;
+  std::string uniqueName = name;
+  while (!state.arrayNames.insert(uniqueName).second)
+    uniqueName = name + "_" + llvm::utostr(++id);
+
+  const ObjectState *os = state.addressSpace.findObject(mo);
+  if (!os) {
+    terminateStateOnUserError(state, "making unbound object tainted");
+    return;
+  }
+  ObjectState *wos = state.addressSpace.getWriteable(mo, os);
+  if (replayKTest) {
+    if (replayPosition >= replayKTest->numObjects) {
+      terminateStateOnUserError(state, "replay count mismatch");
+      return;
+    }
+    KTestObject *obj = &replayKTest->objects[replayPosition++];
+    if (obj->numBytes != mo->size) {
+      terminateStateOnUserError(state, "replay size mismatch");
+      return;
+    }
+    for (unsigned i = 0; i < mo->size; i++)
+      wos->write8(i, obj->bytes[i]);
+  }
+  for (unsigned i = 0; i < mo->size; i++)
+    wos->setTaint(i, taintTracker->label(uniqueName, i));
+}
+
+TaintSet Executor::getOperandTaint(const KInstruction *ki, unsigned index,
+                                   const StackFrame &sf) const {
+  // Constants and globals are never tainted
+  int vnumber = ki->operands[index];
+  return vnumber >= 0 ? sf.locals[vnumber].taint : 0;
+}
+
+TaintSet Executor::getInstructionTaint(const KInstruction *ki,
+                                       const ExecutionState &state) {
+  const StackFrame &sf = state.stack.back();
+  if (isa<PHINode>(ki->inst))
+    return getOperandTaint(ki, state.incomingBBIndex, sf);
+
+  unsigned numOperands = ki->inst->getNumOperands();
+  if (const auto *cb = dyn_cast<CallBase>(ki->inst))
+    numOperands = cb->arg_size() + 1;
+  TaintSet taint = 0;
+  for (unsigned i = 0; i < numOperands; ++i)
+    taint = taintTracker->join(taint, getOperandTaint(ki, i, sf));
+  return taint;
+}
+
+TaintSet Executor::getMemoryTaint(const ObjectState *os,
+                                  const ref<Expr> &offset, unsigned bytes) {
+  unsigned begin = 0, end = os->size;
+  if (const auto *ce = dyn_cast<ConstantExpr>(offset)) {
+    begin = ce->getZExtValue();
+    end = std::min<unsigned>(begin + bytes, os->size);
+  }
+  TaintSet taint = 0;
+  for (unsigned i = begin; i < end; ++i)
+    taint = taintTracker->join(taint, os->getTaint(i));
+  return taint;
+}
+
+void Executor::setMemoryTaint(ObjectState *os, const ref<Expr> &offset,
+                              unsigned bytes, TaintSet taint) {
+  if (const auto *ce = dyn_cast<ConstantExpr>(offset)) {
+    unsigned begin = ce->getZExtValue();
+    unsigned end = std::min<unsigned>(begin + bytes, os->size);
+    for (unsigned i = begin; i < end; ++i)
+      os->setTaint(i, taint);
+  } else {
+    // Any byte may have been written
+    for (unsigned i = 0; i < os->size; ++i)
+      os->setTaint(i, taintTracker->join(os->getTaint(i), taint));
+  }
+}
+
 /***/
 
 void Executor::runFunctionAsMain(Function *f,
@@ -4833,6 +5700,10 @@ void Executor::runFunctionAsMain(Function *f,
 
   ExecutionState *state = new ExecutionState(kmodule->functionMap[f]);
 
+  if (interpreterOpts.CoverageMapSize)
+    state->edgeCoverage =
+        std::make_shared<CoverageMap>(interpreterOpts.CoverageMapSize);
+
   if (pathWriter) 
     state->pathOS = pathWriter->open();
   if (symPathWriter) 
@@ -4878,9 +5749,26 @@ void Executor::runFunctionAsMain(Function *f,
   run(*state);
   processTree = nullptr;
 
+  if (dependencyIndex) {
+    std::string error;
+    if (!dependencyIndex->write(
+            interpreterHandler->getOutputFilename("deps.idx"), error))
+      klee_warning("unable to write deps.idx: %s", error.c_str());
+  }
+  if (taintTracker) {
+    std::string error;
+    if (!taintTracker->getIndex().write(
+            interpreterHandler->getOutputFilename("taint.idx"), error))
+      klee_warning("unable to write taint.idx: %s", error.c_str());
+  }
+  if (exprProfiler) {
+    if (auto os = interpreterHandler->openOutputFile("expr-profile.txt"))
+      exprProfiler->write(*os);
+  }
+
   // hack to clear memory objects
   delete memory;
-  memory = new MemoryManager(NULL);
+  memory = new MemoryManager(&arrayCache);
 
   globalObjects.clear();
   globalAddresses.clear();
@@ -4989,6 +5877,123 @@ void Executor::getCoveredLines(const ExecutionState &state,
   res = state.coveredLines;
 }
 
+const CoverageMap *Executor::getEdgeCoverage(const ExecutionState &state) {
+  return state.edgeCoverage.get();
+}
+
+void Executor::recordConcolicBranch(ExecutionState &state,
+                                    const ref<Expr> &taken,
+                                    bool takenTrue) {
+  // For conditional branches, the successor not taken tells how promising
+  // negating the branch is
+  KInstruction *untakenTarget = nullptr;
+  if (auto *bi = dyn_cast<BranchInst>(state.prevPC->inst)) {
+    if (bi->isConditional()) {
+      KFunction *kf = state.stack.back().kf;
+      untakenTarget = kf->instructions[
+          kf->basicBlockEntry[bi->getSuccessor(takenTrue ? 1 : 0)]];
+    }
+  }
+  state.concolicBranches.push_back(
+      ConcolicBranch{state.concolicConstraints.size(), taken, state.prevPC,
+                     untakenTarget, takenTrue});
+}
+
+void Executor::recordSensitiveOperation(ExecutionState &state) {
+  if (!usingSeeds)
+    return;
+  // Only the number of branches before the operation matters
+  std::size_t position = state.concolicBranches.size();
+  if (state.sensitiveOperations.empty() ||
+      state.sensitiveOperations.back() != position)
+    state.sensitiveOperations.push_back(position);
+}
+
+void Executor::recordDependencies(const ExecutionState &state,
+                                  const ref<Expr> &condition) {
+  std::map<const Array *, std::set<std::uint64_t>> bytes;
+  findReadBytes(condition, bytes);
+  const InstructionInfo &info = *state.prevPC->info;
+  DependencyIndex::Site &site =
+      dependencyIndex->getSite(info.assemblyLine, info.file, info.line);
+  for (const auto &array : bytes) {
+    std::set<std::uint32_t> &siteBytes =
+        site.bytes[dependencyIndex->getObject(array.first->name,
+                                              array.first->size)];
+    siteBytes.insert(array.second.begin(), array.second.end());
+  }
+}
+
+bool Executor::followSeedPrefix(ExecutionState &state,
+                                Solver::Validity &res) {
+  std::size_t position = state.seedPrefixPosition++;
+  if (position >= seedPrefix.size())
+    return false;
+
+  const ConcolicDecision &decision = seedPrefix[position];
+  if (decision.assemblyLine != state.prevPC->info->assemblyLine) {
+    klee_warning("seeded path diverged from the seed prefix at branch %zu, "
+                 "using the solver from here on",
+                 position);
+    state.seedPrefixPosition = seedPrefix.size();
+    return false;
+  }
+  res = decision.direction ? Solver::True : Solver::False;
+  if (position + 1 == seedPrefix.size())
+    klee_message("followed %zu branches of the seed prefix without the "
+                 "solver",
+                 seedPrefix.size());
+  return true;
+}
+
+void Executor::writeFlippedSeeds(const ExecutionState &state,
+                                 const KTest *seed) {
+  std::vector<const Array *> objects;
+  std::vector<std::string> names;
+  for (const auto &symbolic : state.symbolics) {
+    objects.push_back(symbolic.second);
+    names.push_back(symbolic.first->name);
+  }
+
+  unsigned written = 0;
+  for (const auto &branch : state.concolicBranches) {
+    if (!FlipBranchesFilter.empty() &&
+        branch.ki->info->file.find(FlipBranchesFilter) == std::string::npos)
+      continue;
+
+    std::vector<std::vector<unsigned char>> values;
+    if (!ConcolicCampaign::solveFlipped(*solver, coreSolverTimeout,
+                                        state.concolicConstraints, branch,
+                                        objects, values))
+      continue;
+    if (!flippedInputs.insert(ConcolicCampaign::inputKey(values)).second)
+      continue;
+
+    KTest *flipped = ConcolicCampaign::makeSeed(seed, names, values);
+    char filename[32];
+    snprintf(filename, sizeof(filename), "flip%06u", ++numFlippedSeeds);
+    std::string path = interpreterHandler->getOutputFilename(filename);
+    if (kTest_toFile(flipped, (path + ".ktest").c_str()))
+      ++written;
+    else
+      klee_warning("unable to write flipped seed %s.ktest", filename);
+    kTest_free(flipped);
+
+    std::size_t index = &branch - state.concolicBranches.data();
+    if (!writeConcolicPrefix(path + ".prefix",
+                             getFlippedPrefix(state.concolicBranches, index)))
+      klee_warning("unable to write seed prefix %s.prefix", filename);
+  }
+  klee_message("wrote %u flipped seeds for %zu symbolic branches", written,
+               state.concolicBranches.size());
+}
+
+KTest *Executor::getNextConcolicSeed() {
+  if (!concolicCampaign || haltExecution)
+    return nullptr;
+  return concolicCampaign->getNextSeed(*solver, coreSolverTimeout, seedPrefix);
+}
+
 void Executor::doImpliedValueConcretization(ExecutionState &state,
                                             ref<Expr> e,
                                             ref<ConstantExpr> value) {
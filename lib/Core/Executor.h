@@ -16,6 +16,7 @@
 #define KLEE_EXECUTOR_H
 
 #include "ExecutionState.h"
+#include "QueryTimeHistogram.h"
 #include "UserSearcher.h"
 
 #include "klee/ADT/RNG.h"
@@ -24,6 +25,7 @@
 #include "klee/Core/TerminationTypes.h"
 #include "klee/Expr/ArrayCache.h"
 #include "klee/Expr/ArrayExprOptimizer.h"
+#include "klee/Expr/ExprHashMap.h"
 #include "klee/Module/Cell.h"
 #include "klee/Module/KInstruction.h"
 #include "klee/Module/KModule.h"
@@ -60,7 +62,11 @@ namespace llvm {
 namespace klee {  
   class Array;
   struct Cell;
+  class ConcolicCampaign;
+  class DependencyIndex;
+  class TaintTracker;
   class ExecutionState;
+  class ExprProfiler;
   class ExternalDispatcher;
   class Expr;
   class InstructionInfoTable;
@@ -138,7 +144,38 @@ private:
   /// happens with other states (that don't satisfy the seeds) depends
   /// on as-yet-to-be-determined flags.
   std::map<ExecutionState*, std::vector<SeedInfo> > seedMap;
-  
+
+  /// Candidate branches of the --concolic-runs campaign
+  std::unique_ptr<ConcolicCampaign> concolicCampaign;
+
+  /// Inputs of the seeds written by --flip-branches, to skip duplicates
+  std::set<std::string> flippedInputs;
+  unsigned numFlippedSeeds = 0;
+
+  /// Input bytes reaching each instruction, for --shadow-taint
+  std::unique_ptr<TaintTracker> taintTracker;
+
+  /// Largest expressions per instruction, for --dump-expr-profile
+  std::unique_ptr<ExprProfiler> exprProfiler;
+
+  /// Result of an external call of --cache-external-calls
+  struct CachedExternalCall {
+    /// The return value, as written to the argument buffer by the call
+    std::vector<std::uint8_t> result;
+    int error = 0;
+  };
+
+  /// Results of external calls that changed no memory, by
+  /// getExternalCallKey
+  std::unordered_map<std::string, CachedExternalCall> externalCallCache;
+
+  /// Symbolic bytes read by the branch conditions, for --write-dep-index
+  std::unique_ptr<DependencyIndex> dependencyIndex;
+
+  /// Branch decisions of the parent path of the current seed, followed
+  /// without the solver
+  std::vector<ConcolicDecision> seedPrefix;
+
   /// Map of globals to their representative memory object.
   std::map<const llvm::GlobalValue*, MemoryObject*> globalObjects;
 
@@ -184,6 +221,10 @@ private:
   /// (e.g. for a single STP query)
   time::Span coreSolverTimeout;
 
+  /// Times of the solver queries of the current run, for
+  /// --adaptive-solver-timeout
+  QueryTimeHistogram queryTimes;
+
   /// Maximum time to allow for a single instruction.
   time::Span maxInstructionTime;
 
@@ -206,6 +247,33 @@ private:
   /// `nullptr` if merging is disabled
   MergingSearcher *mergingSearcher = nullptr;
 
+  /// Limits of the --max-static-*-pct checks on the counters of a
+  /// KInstruction or CallPathNode. They are only recomputed once the total
+  /// forks or solver time has grown by a set fraction, see
+  /// updateStaticPctLimits().
+  struct StaticPctLimits {
+    std::uint64_t forks, cpForks, solverTime, cpSolverTime;
+    /// Totals at which the limits are recomputed
+    std::uint64_t nextForks = 0, nextSolverTime = 0;
+  } staticPctLimits;
+
+  /// The klee_div_zero_check and klee_overshift_check functions, if linked
+  /// in and --skip-proven-checks is set
+  llvm::Function *divZeroCheckFunction = nullptr;
+  llvm::Function *overshiftCheckFunction = nullptr;
+
+  /// Whether the symbolic conditions of check calls seen so far hold on
+  /// every path, see isProvenCheck()
+  ExprHashMap<bool> provenChecks;
+
+  /// Functions whose calls are skipped with --skip-output-calls when their
+  /// result is unused, see getOutputOnlyFunctions()
+  std::set<const llvm::Function *> outputOnlyFunctions;
+
+  /// Functions run natively on concrete arguments with
+  /// --native-leaf-functions, see ExternalDispatcher::canExecuteNatively
+  std::set<const llvm::Function *> nativeFunctions;
+
   /// Typeids used during exception handling
   std::vector<ref<Expr>> eh_typeids;
 
@@ -217,6 +285,16 @@ private:
   
   void executeInstruction(ExecutionState &state, KInstruction *ki);
 
+  /// Whether f is a check function whose condition holds for the given
+  /// arguments on every path, so that its call can be skipped
+  bool isProvenCheck(ExecutionState &state, llvm::Function *f,
+                     const std::vector<ref<Expr>> &arguments);
+
+  /// Execute a floating point instruction on symbolic operands by building
+  /// the corresponding floating point expression (see --symbolic-fp).
+  /// Returns false if the instruction has to be handled concretely.
+  bool executeSymbolicFP(ExecutionState &state, KInstruction *ki);
+
   void run(ExecutionState &initialState);
 
   // Given a concrete object in our [klee's] address space, add it to 
@@ -244,6 +322,36 @@ private:
                             KCallable *callable,
                             std::vector< ref<Expr> > &arguments);
 
+  /// Run a call to one of nativeFunctions natively if its arguments are
+  /// concrete
+  /// \return false if the call has to be interpreted
+  bool callNativeFunction(ExecutionState &state, KInstruction *target,
+                          KFunction *kf,
+                          const std::vector<ref<Expr>> &arguments);
+
+  /// Key identifying an external call by function, errno, arguments and
+  /// the objects they point to, for --cache-external-calls
+  /// \param numWords The number of words of `args` used by the call
+  /// \return false if the call cannot be cached
+  bool getExternalCallKey(const ExecutionState &state, KCallable *callable,
+                          const uint64_t *args, unsigned numWords,
+                          std::string &key);
+
+  /// Set errno and the return value of an external call from the cache
+  void bindCachedExternalCall(ExecutionState &state, KInstruction *target,
+                              const CachedExternalCall &cached);
+
+  /// Log the outcome of an external call for --record-log: whether it
+  /// succeeded, errno, the return value in `args` and the bytes it changed
+  /// in the concrete memory of the state.
+  void recordExternalCall(ExecutionState &state, KInstruction *target,
+                          uint64_t *args, bool success);
+
+  /// Apply the logged outcome of an external call for --replay-log instead
+  /// of calling it. Returns whether the recorded call succeeded.
+  bool replayExternalCall(ExecutionState &state, KInstruction *target,
+                          uint64_t *args);
+
   ObjectState *bindObjectInState(ExecutionState &state, const MemoryObject *mo,
                                  bool isLocal, const Array *array = 0);
 
@@ -312,6 +420,7 @@ private:
                    KInstruction *ki,
                    llvm::Function *f,
                    std::vector< ref<Expr> > &arguments);
+
                    
   // do address resolution / object binding / out of bounds checking
   // and perform the operation
@@ -321,9 +430,20 @@ private:
                               ref<Expr> value /* undef if read */,
                               KInstruction *target /* undef if write */);
 
+  /// Perform the memory operation at the address of the seed of state,
+  /// once solving for the symbolic address timed out
+  void executeSeedAddress(ExecutionState &state, bool isWrite,
+                          ref<Expr> address, ref<Expr> value,
+                          KInstruction *target);
+
   void executeMakeSymbolic(ExecutionState &state, const MemoryObject *mo,
                            const std::string &name);
 
+  /// With --shadow-taint, label the bytes of an input object instead of
+  /// making it symbolic, replaying its contents if a test is replayed
+  void executeMakeTainted(ExecutionState &state, const MemoryObject *mo,
+                          const std::string &name);
+
   /// Create a new state where each input condition has been added as
   /// a constraint and return the results. The input state is included
   /// as one of the results. Note that the output vector may include
@@ -341,6 +461,22 @@ private:
   // return it. Otherwise, return the unmodified condition.
   ref<Expr> maxStaticPctChecks(ExecutionState &current, ref<Expr> condition);
 
+  /// Recompute staticPctLimits from the current totals
+  void updateStaticPctLimits();
+
+  /// The timeout of a solver query made while executing a path
+  time::Span getSolverTimeout() const;
+
+  /// Whether state follows its seed when one of its queries times out
+  bool followsSeedOnTimeout(const ExecutionState &state) const;
+
+  /// The value of e under the first seed of state, the bytes missing from
+  /// the seed being zero
+  ref<ConstantExpr> getSeedValue(const ExecutionState &state, ref<Expr> e);
+
+  /// Record that condition holds on the seed of state but was not solved
+  void logDroppedConstraint(const ExecutionState &state, ref<Expr> condition);
+
   /// Add the given (boolean) condition as a constraint on state. This
   /// function is a wrapper around the state's addConstraint function
   /// which also manages propagation of implied values,
@@ -373,6 +509,20 @@ private:
                     ExecutionState &state,
                     ref<Expr> value);
 
+  /// Taint of an operand of an instruction in the given frame
+  std::uint32_t getOperandTaint(const KInstruction *ki, unsigned index,
+                                const StackFrame &sf) const;
+  /// Union of the taint of the operands of an instruction in the current
+  /// frame, or of the incoming value for PHI nodes
+  std::uint32_t getInstructionTaint(const KInstruction *ki,
+                                    const ExecutionState &state);
+  /// Union of the taint of the bytes accessed at offset, or of the whole
+  /// object for a symbolic offset
+  std::uint32_t getMemoryTaint(const ObjectState *os, const ref<Expr> &offset,
+                               unsigned bytes);
+  void setMemoryTaint(ObjectState *os, const ref<Expr> &offset,
+                      unsigned bytes, std::uint32_t taint);
+
   /// Evaluates an LLVM constant expression.  The optional argument ki
   /// is the instruction where this constant was encountered, or NULL
   /// if not applicable/unavailable.
@@ -552,6 +702,32 @@ public:
                        std::map<const std::string *, std::set<unsigned>> &res)
       override;
 
+  const CoverageMap *getEdgeCoverage(const ExecutionState &state) override;
+
+  /// Record a symbolic branch taken on a seeded path for the concolic
+  /// campaign, before its condition is added to the constraints
+  void recordConcolicBranch(ExecutionState &state, const ref<Expr> &taken,
+                            bool takenTrue);
+
+  /// Record a memory access with a symbolic offset or a division by a
+  /// symbolic divisor on a seeded path, for --zesti
+  void recordSensitiveOperation(ExecutionState &state);
+
+  /// Add the bytes read by a branch condition to the dependency index
+  void recordDependencies(const ExecutionState &state,
+                          const ref<Expr> &condition);
+
+  /// Follow the next decision of the seed prefix if it is for the current
+  /// branch
+  /// \return false once the prefix is exhausted or the path diverged
+  bool followSeedPrefix(ExecutionState &state, Solver::Validity &res);
+
+  /// Write a seed for every recorded branch of a terminating seeded state,
+  /// solving the constraints before the branch with the branch negated
+  void writeFlippedSeeds(const ExecutionState &state, const KTest *seed);
+
+  KTest *getNextConcolicSeed() override;
+
   Expr::Width getWidthForLLVMType(llvm::Type *type) const;
   size_t getAllocationAlignment(const llvm::Value *allocSite) const;
 
@@ -0,0 +1,76 @@
+//===-- ExprProfiler.cpp --------------------------------------------------===//
+//
+//                     The KLEE Symbolic Virtual Machine
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "ExprProfiler.h"
+
+#include "klee/Module/InstructionInfoTable.h"
+#include "klee/Module/KInstruction.h"
+
+#include "llvm/IR/Function.h"
+#include "llvm/IR/Instruction.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace klee;
+
+namespace {
+/// Distinct expressions whose shapes are remembered between two resets
+const std::uint64_t MaxCachedShapes = 1 << 18;
+} // namespace
+
+ExprProfiler::ExprProfiler() : shapes(std::make_unique<ExprDAGStats>()) {}
+
+void ExprProfiler::record(const KInstruction *ki, const ref<Expr> &e) {
+  if (isa<ConstantExpr>(e))
+    return;
+  if (shapes->getNumNodes() > MaxCachedShapes)
+    shapes = std::make_unique<ExprDAGStats>();
+
+  ExprDAGStats::Shape shape = shapes->add(e);
+  Record &r = records[ki];
+  ++r.count;
+  if (shape.treeSize > r.largest.treeSize ||
+      (shape.treeSize == r.largest.treeSize &&
+       shape.depth > r.largest.depth)) {
+    r.largest = shape;
+    r.kind = e->getKind();
+  }
+}
+
+void ExprProfiler::write(llvm::raw_ostream &os) const {
+  std::vector<std::pair<const KInstruction *, const Record *>> sorted;
+  for (const auto &entry : records)
+    sorted.emplace_back(entry.first, &entry.second);
+  std::sort(sorted.begin(), sorted.end(), [](const auto &a, const auto &b) {
+    if (a.second->largest.treeSize != b.second->largest.treeSize)
+      return a.second->largest.treeSize > b.second->largest.treeSize;
+    return a.first->info->id < b.first->info->id;
+  });
+
+  os << "# tree size\tdepth\tkind\tsymbolic values\tlocation\tfunction"
+        "\tinstruction\n";
+  for (const auto &entry : sorted) {
+    const KInstruction *ki = entry.first;
+    const Record &r = *entry.second;
+    os << llvm::format("%.0f", r.largest.treeSize) << '\t' << r.largest.depth
+       << '\t';
+    Expr::printKind(os, r.kind);
+    os << '\t' << r.count << '\t';
+    if (ki->info->file.empty())
+      os << "assembly.ll:" << ki->info->assemblyLine;
+    else
+      os << ki->info->file << ':' << ki->info->line;
+    os << '\t' << ki->inst->getFunction()->getName() << '\t'
+       << ki->inst->getOpcodeName() << '\n';
+  }
+}
@@ -0,0 +1,60 @@
+//===-- ExprProfiler.h ------------------------------------------*- C++ -*-===//
+//
+//                     The KLEE Symbolic Virtual Machine
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+/**
+ * @file ExprProfiler.h
+ * @brief Largest expressions per instruction for --dump-expr-profile
+ *
+ * Every symbolic value bound to a register is measured by the size of the
+ * tree it unfolds to and by its depth, and the largest one is kept for the
+ * instruction that computed it, so that the source locations behind an
+ * expression blow-up can be found.
+ */
+
+#ifndef KLEE_EXPRPROFILER_H
+#define KLEE_EXPRPROFILER_H
+
+#include "klee/Expr/Expr.h"
+#include "klee/Expr/ExprUtil.h"
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+
+namespace llvm {
+class raw_ostream;
+}
+
+namespace klee {
+struct KInstruction;
+
+class ExprProfiler {
+  struct Record {
+    std::uint64_t count = 0;
+    ExprDAGStats::Shape largest{0, 0};
+    Expr::Kind kind = Expr::InvalidKind;
+  };
+
+  std::unordered_map<const KInstruction *, Record> records;
+
+  /// Shapes of the expressions measured so far, dropped once too large
+  std::unique_ptr<ExprDAGStats> shapes;
+
+public:
+  ExprProfiler();
+
+  /// Record that ki computed e
+  void record(const KInstruction *ki, const ref<Expr> &e);
+
+  /// Write the instructions by decreasing size of their largest expression
+  void write(llvm::raw_ostream &os) const;
+};
+} // namespace klee
+
+#endif /* KLEE_EXPRPROFILER_H */
@@ -14,9 +14,12 @@
 
 #include "llvm/IR/Constants.h"
 #include "llvm/IR/DerivedTypes.h"
+#include "llvm/IR/DebugInfo.h"
 #include "llvm/IR/IRBuilder.h"
 #include "llvm/IR/InlineAsm.h"
+#include "llvm/IR/InstIterator.h"
 #include "llvm/IR/Instructions.h"
+#include "llvm/IR/IntrinsicInst.h"
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/Module.h"
 #include "llvm/ExecutionEngine/GenericValue.h"
@@ -24,6 +27,7 @@
 #include "llvm/Support/DynamicLibrary.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Support/TargetSelect.h"
+#include "llvm/Transforms/Utils/Cloning.h"
 
 #include <csetjmp>
 #include <csignal>
@@ -42,14 +46,32 @@ static void sigsegv_handler(int signal, siginfo_t *info, void *context) {
 }
 }
 
+/// Call f on the globals used by a value, looking through constants
+template <typename F> static void forEachGlobal(const Value *v, F f) {
+  if (auto gv = dyn_cast<GlobalValue>(v)) {
+    f(gv);
+  } else if (auto c = dyn_cast<Constant>(v)) {
+    for (const Use &op : c->operands())
+      forEachGlobal(op.get(), f);
+  }
+}
+
 namespace klee {
 
 class ExternalDispatcherImpl {
 private:
   typedef std::map<const llvm::Instruction *, llvm::Function *> dispatchers_ty;
   dispatchers_ty dispatchers;
+  /// Dispatchers of the calls run natively, by call site and callee
+  std::map<std::pair<const llvm::Instruction *, const llvm::Function *>,
+           llvm::Function *>
+      nativeDispatchers;
   llvm::Function *createDispatcher(KCallable *target, llvm::Instruction *i,
-                                   llvm::Module *module);
+                                   llvm::Module *module,
+                                   llvm::Function *native = nullptr);
+  llvm::Function *compileDispatcher(KCallable *target, llvm::Instruction *i,
+                                    bool native);
+  llvm::Function *cloneNative(const llvm::Function *f, llvm::Module *module);
   llvm::ExecutionEngine *executionEngine;
   LLVMContext &ctx;
   std::map<std::string, void *> preboundFunctions;
@@ -64,6 +86,8 @@ public:
   ~ExternalDispatcherImpl();
   bool executeCall(KCallable *callable, llvm::Instruction *i,
                    uint64_t *args);
+  bool executeNativeCall(KFunction *kf, llvm::Instruction *i,
+                         uint64_t *args);
   void *resolveSymbol(const std::string &name);
   int getLastErrno();
   void setLastErrno(int newErrno);
@@ -165,7 +189,6 @@ bool ExternalDispatcherImpl::executeCall(KCallable *callable, Instruction *i,
   }
 
   // Code for this not JIT'ed. Do this now.
-  Function *dispatcher;
 #ifdef WINDOWS
   std::map<std::string, void *>::iterator it2 =
       preboundFunctions.find(f->getName());
@@ -179,12 +202,33 @@ bool ExternalDispatcherImpl::executeCall(KCallable *callable, Instruction *i,
   }
 #endif
 
-  Module *dispatchModule = NULL;
+  Function *dispatcher = compileDispatcher(callable, i, false);
+  dispatchers.insert(std::make_pair(i, dispatcher));
+  return runProtectedCall(dispatcher, args);
+}
+
+bool ExternalDispatcherImpl::executeNativeCall(KFunction *kf, Instruction *i,
+                                               uint64_t *args) {
+  auto key = std::make_pair(i, kf->function);
+  auto it = nativeDispatchers.find(key);
+  if (it == nativeDispatchers.end())
+    it = nativeDispatchers.insert(
+        std::make_pair(key, compileDispatcher(kf, i, true))).first;
+  return runProtectedCall(it->second, args);
+}
+
+Function *ExternalDispatcherImpl::compileDispatcher(KCallable *target,
+                                                    Instruction *i,
+                                                    bool native) {
   // The MCJIT generates whole modules at a time so for every call that we
   // haven't made before we need to create a new Module.
-  dispatchModule = new Module(getFreshModuleID(), ctx);
-  dispatcher = createDispatcher(callable, i, dispatchModule);
-  dispatchers.insert(std::make_pair(i, dispatcher));
+  Module *dispatchModule = new Module(getFreshModuleID(), ctx);
+  Function *nativeTarget = nullptr;
+  if (native)
+    nativeTarget =
+        cloneNative(cast<KFunction>(target)->function, dispatchModule);
+  Function *dispatcher =
+      createDispatcher(target, i, dispatchModule, nativeTarget);
 
   // Force the JIT execution engine to go ahead and build the function. This
   // ensures that any errors or assertions in the compilation process will
@@ -206,7 +250,52 @@ bool ExternalDispatcherImpl::executeCall(KCallable *callable, Instruction *i,
     // MCJIT didn't take ownership of the module so delete it.
     delete dispatchModule;
   }
-  return runProtectedCall(dispatcher, args);
+  return dispatcher;
+}
+
+/// Copy f into module under a fresh name, with copies of the constant
+/// globals it reads. f must satisfy ExternalDispatcher::canExecuteNatively.
+Function *ExternalDispatcherImpl::cloneNative(const Function *f,
+                                              Module *module) {
+  Function *clone = Function::Create(
+      f->getFunctionType(), GlobalValue::InternalLinkage,
+      "native_" + f->getName() + module->getModuleIdentifier(), module);
+
+  ValueToValueMapTy vmap;
+  auto arg = clone->arg_begin();
+  for (const Argument &a : f->args())
+    vmap[&a] = &*arg++;
+  for (const Instruction &i : instructions(*f)) {
+    for (const Use &op : i.operands()) {
+      forEachGlobal(op.get(), [module, &vmap](const GlobalValue *gv) {
+        if (vmap.count(gv))
+          return;
+        if (auto var = dyn_cast<GlobalVariable>(gv)) {
+          vmap[var] = new GlobalVariable(
+              *module, var->getValueType(), true, GlobalValue::PrivateLinkage,
+              const_cast<Constant *>(var->getInitializer()), var->getName());
+        } else if (auto callee = dyn_cast<Function>(gv)) {
+          // Only intrinsics are called
+          vmap[callee] = cast<Function>(
+              module
+                  ->getOrInsertFunction(callee->getName(),
+                                        callee->getFunctionType(),
+                                        callee->getAttributes())
+                  .getCallee());
+        }
+      });
+    }
+  }
+
+  SmallVector<ReturnInst *, 8> returns;
+#if LLVM_VERSION_CODE >= LLVM_VERSION(13, 0)
+  CloneFunctionInto(clone, f, vmap, CloneFunctionChangeType::DifferentModule,
+                    returns);
+#else
+  CloneFunctionInto(clone, f, vmap, /*ModuleLevelChanges=*/true, returns);
+#endif
+  stripDebugInfo(*clone);
+  return clone;
 }
 
 // FIXME: This is not reentrant.
@@ -254,8 +343,10 @@ bool ExternalDispatcherImpl::runProtectedCall(Function *f, uint64_t *args) {
 // stub, for every single function call.
 Function *ExternalDispatcherImpl::createDispatcher(KCallable *target,
                                                    Instruction *inst,
-                                                   Module *module) {
-  if (isa<KFunction>(target) && !resolveSymbol(target->getName().str()))
+                                                   Module *module,
+                                                   Function *native) {
+  if (!native && isa<KFunction>(target) &&
+      !resolveSymbol(target->getName().str()))
     return 0;
 
   const CallBase &cb = cast<CallBase>(*inst);
@@ -313,7 +404,10 @@ Function *ExternalDispatcherImpl::createDispatcher(KCallable *target,
   }
 
   llvm::CallInst *result;
-  if (auto* func = dyn_cast<KFunction>(target)) {
+  if (native) {
+    result = Builder.CreateCall(native,
+                                llvm::ArrayRef<Value *>(args, args + i));
+  } else if (auto* func = dyn_cast<KFunction>(target)) {
     auto dispatchTarget = module->getOrInsertFunction(target->getName(), FTy,
                                                       func->function->getAttributes());
     result = Builder.CreateCall(dispatchTarget,
@@ -352,6 +446,129 @@ bool ExternalDispatcher::executeCall(KCallable *callable,
   return impl->executeCall(callable, i, args);
 }
 
+bool ExternalDispatcher::executeNativeCall(KFunction *kf, llvm::Instruction *i,
+                                           uint64_t *args) {
+  return impl->executeNativeCall(kf, i, args);
+}
+
+/// Whether an access of size bytes at pointer stays within a stack object,
+/// at an offset known without running the function
+static bool isInBoundsStackAccess(const Value *pointer, uint64_t size,
+                                  const DataLayout &dl) {
+  APInt offset(dl.getIndexTypeSizeInBits(pointer->getType()), 0);
+  const Value *base = pointer->stripAndAccumulateConstantOffsets(
+      dl, offset, /*AllowNonInbounds=*/true);
+  auto alloca = dyn_cast<AllocaInst>(base);
+  if (!alloca)
+    return false;
+  auto count = dyn_cast<ConstantInt>(alloca->getArraySize());
+  if (!count || offset.isNegative())
+    return false;
+  uint64_t allocSize = dl.getTypeAllocSize(alloca->getAllocatedType()) *
+                       count->getZExtValue();
+  return offset.getZExtValue() <= allocSize &&
+         size <= allocSize - offset.getZExtValue();
+}
+
+bool ExternalDispatcher::canExecuteNatively(const llvm::Function &f) {
+  auto isValueType = [](const Type *t) {
+    return t->isIntegerTy() || t->isFloatingPointTy();
+  };
+  if (f.isDeclaration() || f.isVarArg() || !isValueType(f.getReturnType()))
+    return false;
+  for (const Argument &a : f.args())
+    if (!isValueType(a.getType()))
+      return false;
+
+  const DataLayout &dl = f.getParent()->getDataLayout();
+  for (const Instruction &i : instructions(f)) {
+    switch (i.getOpcode()) {
+    case Instruction::SDiv:
+    case Instruction::SRem:
+    case Instruction::UDiv:
+    case Instruction::URem: {
+      // The host traps where the interpreter reports an error
+      auto divisor = dyn_cast<ConstantInt>(i.getOperand(1));
+      if (!divisor || divisor->isZero() ||
+          (divisor->isMinusOne() && (i.getOpcode() == Instruction::SDiv ||
+                                     i.getOpcode() == Instruction::SRem)))
+        return false;
+      break;
+    }
+    case Instruction::Shl:
+    case Instruction::LShr:
+    case Instruction::AShr: {
+      // The host masks the shift amount where the interpreter yields zero
+      // or reports an overshift
+      auto amount = dyn_cast<ConstantInt>(i.getOperand(1));
+      if (!amount ||
+          amount->getValue().uge(i.getType()->getScalarSizeInBits()))
+        return false;
+      break;
+    }
+    case Instruction::Load: {
+      // Only the stack can be read, and only where the interpreter would
+      // not report an out of bounds access
+      auto &load = cast<LoadInst>(i);
+      if (load.isVolatile() ||
+          !isInBoundsStackAccess(load.getPointerOperand(),
+                                 dl.getTypeStoreSize(load.getType()), dl))
+        return false;
+      break;
+    }
+    case Instruction::Store: {
+      // Only the stack can be written, as for loads
+      auto &store = cast<StoreInst>(i);
+      if (store.isVolatile() ||
+          !isInBoundsStackAccess(
+              store.getPointerOperand(),
+              dl.getTypeStoreSize(store.getValueOperand()->getType()), dl))
+        return false;
+      break;
+    }
+    case Instruction::ICmp:
+      // Stack addresses differ between the host and the interpreter
+      if (i.getOperand(0)->getType()->isPtrOrPtrVectorTy())
+        return false;
+      break;
+    case Instruction::Call: {
+      auto ii = dyn_cast<IntrinsicInst>(&i);
+      if (!ii || !(isa<DbgInfoIntrinsic>(ii) || ii->doesNotAccessMemory()))
+        return false;
+      continue;
+    }
+    case Instruction::IntToPtr:
+    case Instruction::PtrToInt:
+    case Instruction::Invoke:
+    case Instruction::Resume:
+    case Instruction::Unreachable:
+    case Instruction::AtomicRMW:
+    case Instruction::AtomicCmpXchg:
+    case Instruction::Fence:
+      return false;
+    default:
+      break;
+    }
+
+    // Only globals that are read-only and whose contents are known, which
+    // cloneNative copies
+    for (const Use &op : i.operands()) {
+      bool allowed = true;
+      forEachGlobal(op.get(), [&allowed](const GlobalValue *gv) {
+        auto var = dyn_cast<GlobalVariable>(gv);
+        if (!var || !var->isConstant() || !var->hasDefinitiveInitializer())
+          allowed = false;
+        else
+          forEachGlobal(var->getInitializer(),
+                        [&allowed](const GlobalValue *) { allowed = false; });
+      });
+      if (!allowed)
+        return false;
+    }
+  }
+  return true;
+}
+
 void *ExternalDispatcher::resolveSymbol(const std::string &name) {
   return impl->resolveSymbol(name);
 }
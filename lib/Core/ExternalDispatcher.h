@@ -18,6 +18,7 @@
 #include <string>
 
 namespace llvm {
+class Function;
 class Instruction;
 class LLVMContext;
 }
@@ -25,6 +26,7 @@ class LLVMContext;
 namespace klee {
 class ExternalDispatcherImpl;
 class KCallable;
+struct KFunction;
 class ExternalDispatcher {
 private:
   ExternalDispatcherImpl *impl;
@@ -39,6 +41,21 @@ public:
    */
   bool executeCall(KCallable *callable, llvm::Instruction *i,
                    uint64_t *args);
+
+  /* Run a function defined in the interpreted module natively, with the
+   * same argument passing as executeCall. The function must satisfy
+   * canExecuteNatively.
+   */
+  bool executeNativeCall(KFunction *kf, llvm::Instruction *i, uint64_t *args);
+
+  /* Whether a defined function computes its result only from its integer
+   * and floating point arguments and its stack, without calls, without
+   * memory accesses that are not provably in bounds and without operations
+   * that trap or behave differently on the host, so that running it
+   * natively gives the result the interpreter would.
+   */
+  static bool canExecuteNatively(const llvm::Function &f);
+
   void *resolveSymbol(const std::string &name);
 
   int getLastErrno();
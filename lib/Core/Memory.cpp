@@ -24,6 +24,7 @@
 #include "llvm/IR/Instruction.h"
 #include "llvm/IR/Value.h"
 #include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Endian.h"
 #include "llvm/Support/raw_ostream.h"
 
 #include <cassert>
@@ -38,6 +39,18 @@ namespace {
                     cl::desc("Use constant arrays instead of updates when possible (default=true)\n"),
                     cl::init(true),
                     cl::cat(SolvingCat));
+
+  /// Load a T stored in target byte order E at an arbitrarily aligned address.
+  template <typename T, llvm::support::endianness E>
+  inline T loadConcrete(const uint8_t *p) {
+    return llvm::support::endian::read<T, E, llvm::support::unaligned>(p);
+  }
+
+  /// Store a T in target byte order E at an arbitrarily aligned address.
+  template <typename T, llvm::support::endianness E>
+  inline void storeConcrete(uint8_t *p, T value) {
+    llvm::support::endian::write<T, E, llvm::support::unaligned>(p, value);
+  }
 }
 
 /***/
@@ -115,6 +128,7 @@ ObjectState::ObjectState(const ObjectState &os)
     knownSymbolics(nullptr),
     unflushedMask(os.unflushedMask ? new BitArray(*os.unflushedMask, os.size) : nullptr),
     updates(os.updates),
+    taint(os.taint),
     size(os.size),
     readOnly(false) {
   assert(!os.readOnly && "no need to copy read only object?");
@@ -179,8 +193,8 @@ const UpdateList &ObjectState::getUpdates() const {
     }
 
     static unsigned id = 0;
-    const Array *array = getArrayCache()->CreateArray(
-        "const_arr" + llvm::utostr(++id), size, &Contents[0],
+    const Array *array = getArrayCache()->CreateConstantArray(
+        "const_arr" + llvm::utostr(++id), &Contents[0],
         &Contents[0] + Contents.size());
     updates = UpdateList(array, 0);
 
@@ -194,7 +208,12 @@ const UpdateList &ObjectState::getUpdates() const {
 
 void ObjectState::flushToConcreteStore(TimingSolver *solver,
                                        const ExecutionState &state) const {
-  for (unsigned i = 0; i < size; i++) {
+  // Only non-concrete bytes can be known symbolic.
+  if (!concreteMask || !knownSymbolics)
+    return;
+
+  for (unsigned i = concreteMask->findFirstUnset(0, size); i < size;
+       i = concreteMask->findFirstUnset(i + 1, size)) {
     if (isByteKnownSymbolic(i)) {
       ref<ConstantExpr> ce;
       bool success = solver->getValue(state.constraints, read8(i), ce,
@@ -222,12 +241,18 @@ void ObjectState::makeSymbolic() {
   assert(!updates.head &&
          "XXX makeSymbolic of objects with symbolic values is unsupported");
 
-  // XXX simplify this, can just delete various arrays I guess
-  for (unsigned i=0; i<size; i++) {
-    markByteSymbolic(i);
-    setKnownSymbolic(i, 0);
-    markByteFlushed(i);
-  }
+  if (!concreteMask)
+    concreteMask = new BitArray(size, false);
+  else
+    concreteMask->unsetRange(0, size);
+
+  if (!unflushedMask)
+    unflushedMask = new BitArray(size, false);
+  else
+    unflushedMask->unsetRange(0, size);
+
+  delete[] knownSymbolics;
+  knownSymbolics = nullptr;
 }
 
 void ObjectState::initializeToZero() {
@@ -237,10 +262,8 @@ void ObjectState::initializeToZero() {
 
 void ObjectState::initializeToRandom() {  
   makeConcrete();
-  for (unsigned i=0; i<size; i++) {
-    // randomly selected by 256 sided die
-    concreteStore[i] = 0xAB;
-  }
+  // randomly selected by 256 sided die
+  memset(concreteStore, 0xAB, size);
 }
 
 /*
@@ -263,52 +286,49 @@ void ObjectState::flushRangeForRead(unsigned rangeBase,
   if (!unflushedMask)
     unflushedMask = new BitArray(size, true);
 
-  for (unsigned offset = rangeBase; offset < rangeBase + rangeSize; offset++) {
-    if (isByteUnflushed(offset)) {
-      if (isByteConcrete(offset)) {
-        updates.extend(ConstantExpr::create(offset, Expr::Int32),
-                       ConstantExpr::create(concreteStore[offset], Expr::Int8));
-      } else {
-        assert(isByteKnownSymbolic(offset) &&
-               "invalid bit set in unflushedMask");
-        updates.extend(ConstantExpr::create(offset, Expr::Int32),
-                       knownSymbolics[offset]);
-      }
-
-      unflushedMask->unset(offset);
+  unsigned rangeEnd = rangeBase + rangeSize;
+  for (unsigned offset = unflushedMask->findFirstSet(rangeBase, rangeEnd);
+       offset < rangeEnd;
+       offset = unflushedMask->findFirstSet(offset + 1, rangeEnd)) {
+    if (isByteConcrete(offset)) {
+      updates.extend(ConstantExpr::create(offset, Expr::Int32),
+                     ConstantExpr::create(concreteStore[offset], Expr::Int8));
+    } else {
+      assert(isByteKnownSymbolic(offset) && "invalid bit set in unflushedMask");
+      updates.extend(ConstantExpr::create(offset, Expr::Int32),
+                     knownSymbolics[offset]);
     }
   }
+  unflushedMask->unsetRange(rangeBase, rangeEnd);
 }
 
 void ObjectState::flushRangeForWrite(unsigned rangeBase, unsigned rangeSize) {
   if (!unflushedMask)
     unflushedMask = new BitArray(size, true);
 
-  for (unsigned offset = rangeBase; offset < rangeBase + rangeSize; offset++) {
-    if (isByteUnflushed(offset)) {
-      if (isByteConcrete(offset)) {
-        updates.extend(ConstantExpr::create(offset, Expr::Int32),
-                       ConstantExpr::create(concreteStore[offset], Expr::Int8));
-        markByteSymbolic(offset);
-      } else {
-        assert(isByteKnownSymbolic(offset) &&
-               "invalid bit set in unflushedMask");
-        updates.extend(ConstantExpr::create(offset, Expr::Int32),
-                       knownSymbolics[offset]);
-        setKnownSymbolic(offset, 0);
-      }
-
-      unflushedMask->unset(offset);
+  unsigned rangeEnd = rangeBase + rangeSize;
+  for (unsigned offset = unflushedMask->findFirstSet(rangeBase, rangeEnd);
+       offset < rangeEnd;
+       offset = unflushedMask->findFirstSet(offset + 1, rangeEnd)) {
+    if (isByteConcrete(offset)) {
+      updates.extend(ConstantExpr::create(offset, Expr::Int32),
+                     ConstantExpr::create(concreteStore[offset], Expr::Int8));
     } else {
-      // flushed bytes that are written over still need
-      // to be marked out
-      if (isByteConcrete(offset)) {
-        markByteSymbolic(offset);
-      } else if (isByteKnownSymbolic(offset)) {
-        setKnownSymbolic(offset, 0);
-      }
+      assert(isByteKnownSymbolic(offset) && "invalid bit set in unflushedMask");
+      updates.extend(ConstantExpr::create(offset, Expr::Int32),
+                     knownSymbolics[offset]);
     }
   }
+  unflushedMask->unsetRange(rangeBase, rangeEnd);
+
+  // Every byte in the range, flushed or not, is now only described by the
+  // update list, so mark it out of both caches.
+  if (!concreteMask)
+    concreteMask = new BitArray(size, true);
+  concreteMask->unsetRange(rangeBase, rangeEnd);
+  if (knownSymbolics)
+    for (unsigned offset = rangeBase; offset < rangeEnd; offset++)
+      knownSymbolics[offset] = nullptr;
 }
 
 bool ObjectState::isByteConcrete(unsigned offset) const {
@@ -359,6 +379,42 @@ void ObjectState::setKnownSymbolic(unsigned offset,
   }
 }
 
+bool ObjectState::isRangeConcrete(unsigned offset, unsigned numBytes) const {
+  return !concreteMask || concreteMask->allSet(offset, offset + numBytes);
+}
+
+template <typename T>
+ref<Expr> ObjectState::readConcrete(unsigned offset) const {
+  const uint8_t *p = concreteStore + offset;
+  T value = Context::get().isLittleEndian()
+                ? loadConcrete<T, llvm::support::little>(p)
+                : loadConcrete<T, llvm::support::big>(p);
+  return ConstantExpr::create(value, sizeof(T) * 8);
+}
+
+template <typename T>
+void ObjectState::writeConcrete(unsigned offset, T value) {
+  uint8_t *p = concreteStore + offset;
+  if (Context::get().isLittleEndian())
+    storeConcrete<T, llvm::support::little>(p, value);
+  else
+    storeConcrete<T, llvm::support::big>(p, value);
+
+  // Objects that were never made symbolic and never flushed need no
+  // bookkeeping at all, which is by far the most common case.
+  if (!concreteMask && !knownSymbolics && !unflushedMask)
+    return;
+
+  unsigned end = offset + sizeof(T);
+  if (knownSymbolics)
+    for (unsigned i = offset; i != end; ++i)
+      knownSymbolics[i] = nullptr;
+  if (concreteMask)
+    concreteMask->setRange(offset, end);
+  if (unflushedMask)
+    unflushedMask->setRange(offset, end);
+}
+
 /***/
 
 ref<Expr> ObjectState::read8(unsigned offset) const {
@@ -463,6 +519,17 @@ ref<Expr> ObjectState::read(unsigned offset, Expr::Width width) const {
   if (width == Expr::Bool)
     return ExtractExpr::create(read8(offset), 0, Expr::Bool);
 
+  // Fast path for fully concrete reads of native integer widths.
+  if (width <= Expr::Int64 && isRangeConcrete(offset, width / 8)) {
+    switch (width) {
+    case Expr::Int8:  return readConcrete<uint8_t>(offset);
+    case Expr::Int16: return readConcrete<uint16_t>(offset);
+    case Expr::Int32: return readConcrete<uint32_t>(offset);
+    case Expr::Int64: return readConcrete<uint64_t>(offset);
+    default: break;
+    }
+  }
+
   // Otherwise, follow the slow general case.
   unsigned NumBytes = width / 8;
   assert(width == NumBytes * 8 && "Invalid width for read size!");
@@ -537,27 +604,25 @@ void ObjectState::write(unsigned offset, ref<Expr> value) {
 } 
 
 void ObjectState::write16(unsigned offset, uint16_t value) {
-  unsigned NumBytes = 2;
-  for (unsigned i = 0; i != NumBytes; ++i) {
-    unsigned idx = Context::get().isLittleEndian() ? i : (NumBytes - i - 1);
-    write8(offset + idx, (uint8_t) (value >> (8 * i)));
-  }
+  writeConcrete<uint16_t>(offset, value);
 }
 
 void ObjectState::write32(unsigned offset, uint32_t value) {
-  unsigned NumBytes = 4;
-  for (unsigned i = 0; i != NumBytes; ++i) {
-    unsigned idx = Context::get().isLittleEndian() ? i : (NumBytes - i - 1);
-    write8(offset + idx, (uint8_t) (value >> (8 * i)));
-  }
+  writeConcrete<uint32_t>(offset, value);
 }
 
 void ObjectState::write64(unsigned offset, uint64_t value) {
-  unsigned NumBytes = 8;
-  for (unsigned i = 0; i != NumBytes; ++i) {
-    unsigned idx = Context::get().isLittleEndian() ? i : (NumBytes - i - 1);
-    write8(offset + idx, (uint8_t) (value >> (8 * i)));
+  writeConcrete<uint64_t>(offset, value);
+}
+
+void ObjectState::setTaint(unsigned offset, std::uint32_t labels) {
+  assert(offset < size && "taint offset out of bounds");
+  if (taint.empty()) {
+    if (!labels)
+      return;
+    taint.resize(size, 0);
   }
+  taint[offset] = labels;
 }
 
 void ObjectState::print() const {
@@ -189,6 +189,10 @@ private:
   // mutable because we may need flush during read of const
   mutable UpdateList updates;
 
+  /// Taint labels of each byte with --shadow-taint (see TaintTracker),
+  /// empty while no byte is tainted
+  std::vector<std::uint32_t> taint;
+
 public:
   unsigned size;
 
@@ -230,6 +234,12 @@ public:
   void write64(unsigned offset, uint64_t value);
   void print() const;
 
+  /// Taint labels of a byte, 0 if untainted
+  std::uint32_t getTaint(unsigned offset) const {
+    return offset < taint.size() ? taint[offset] : 0;
+  }
+  void setTaint(unsigned offset, std::uint32_t labels);
+
   /*
     Looks at all the symbolic bytes of this object, gets a value for them
     from the solver and puts them in the concreteStore.
@@ -268,6 +278,17 @@ private:
   void markByteUnflushed(unsigned offset);
   void setKnownSymbolic(unsigned offset, Expr *value);
 
+  /// Returns true if every byte in [offset, offset + numBytes) is concrete.
+  bool isRangeConcrete(unsigned offset, unsigned numBytes) const;
+
+  /// Fast path for reads of a fully concrete 1/2/4/8-byte range: loads the
+  /// bytes straight from the concrete store into a native integer.
+  template <typename T> ref<Expr> readConcrete(unsigned offset) const;
+
+  /// Fast path for concrete 1/2/4/8-byte writes, equivalent to calling
+  /// write8(unsigned, uint8_t) for every byte in the range.
+  template <typename T> void writeConcrete(unsigned offset, T value);
+
   ArrayCache *getArrayCache() const;
 };
   
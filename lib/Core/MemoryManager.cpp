@@ -14,6 +14,7 @@
 
 #include "klee/Expr/Expr.h"
 #include "klee/Support/ErrorHandling.h"
+#include "klee/Support/ReplayLog.h"
 
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/MathExtras.h"
@@ -145,6 +146,11 @@ MemoryObject *MemoryManager::allocate(uint64_t size, bool isLocal,
   if (!address)
     return 0;
 
+  // Host addresses cannot be forced, only checked against the replayed run
+  if (ReplayLog::sync(ReplayEventKind::Allocation, address) != address)
+    klee_warning_once(0, "allocation addresses differ from the replay log, "
+                         "record and replay with --allocate-determ");
+
   ++stats::allocations;
   MemoryObject *res = new MemoryObject(address, size, isLocal, isGlobal, false,
                                        allocSite, this);
@@ -0,0 +1,44 @@
+//===-- QueryTimeHistogram.cpp --------------------------------------------===//
+//
+//                     The KLEE Symbolic Virtual Machine
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "QueryTimeHistogram.h"
+
+#include <cmath>
+
+using namespace klee;
+
+void QueryTimeHistogram::add(time::Span t) {
+  std::uint64_t us = t.toMicroseconds();
+  std::size_t i = 0;
+  while (i + 1 < buckets.size() && us >= (std::uint64_t(1) << i))
+    ++i;
+  ++buckets[i];
+  ++count;
+}
+
+void QueryTimeHistogram::clear() {
+  buckets.fill(0);
+  count = 0;
+}
+
+time::Span QueryTimeHistogram::getQuantile(double q) const {
+  if (!count)
+    return time::Span();
+  auto rank = static_cast<std::uint64_t>(std::ceil(q * count));
+  if (rank < 1)
+    rank = 1;
+  std::uint64_t seen = 0;
+  std::size_t i = 0;
+  for (; i + 1 < buckets.size(); ++i) {
+    seen += buckets[i];
+    if (seen >= rank)
+      break;
+  }
+  return time::microseconds(std::uint64_t(1) << i);
+}
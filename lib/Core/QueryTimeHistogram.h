@@ -0,0 +1,48 @@
+//===-- QueryTimeHistogram.h ------------------------------------*- C++ -*-===//
+//
+//                     The KLEE Symbolic Virtual Machine
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+/**
+ * @file QueryTimeHistogram.h
+ * @brief Distribution of the solver query times for --adaptive-solver-timeout
+ *
+ * Query times are counted in power-of-two buckets of microseconds, so that a
+ * quantile is known within a factor of two at a constant cost per query.
+ */
+
+#ifndef KLEE_QUERYTIMEHISTOGRAM_H
+#define KLEE_QUERYTIMEHISTOGRAM_H
+
+#include "klee/System/Time.h"
+
+#include <array>
+#include <cstdint>
+
+namespace klee {
+
+class QueryTimeHistogram {
+  /// Bucket i counts the queries of less than 2^i microseconds that do not
+  /// fit in bucket i - 1
+  std::array<std::uint64_t, 48> buckets{};
+  std::uint64_t count = 0;
+
+public:
+  /// Record a query of time t
+  void add(time::Span t);
+
+  /// Forget the queries recorded so far
+  void clear();
+
+  std::uint64_t size() const { return count; }
+
+  /// Upper bound of the q-quantile of the recorded times, zero if none
+  time::Span getQuantile(double q) const;
+};
+} // namespace klee
+
+#endif /* KLEE_QUERYTIMEHISTOGRAM_H */
@@ -16,6 +16,7 @@
 #include "MergeHandler.h"
 #include "Searcher.h"
 #include "StatsTracker.h"
+#include "TaintTracker.h"
 #include "TimingSolver.h"
 
 #include "klee/Config/config.h"
@@ -26,6 +27,7 @@
 #include "klee/Support/Casting.h"
 #include "klee/Support/Debug.h"
 #include "klee/Support/ErrorHandling.h"
+#include "klee/Support/EventLog.h"
 #include "klee/Support/OptionCategories.h"
 
 #include "llvm/ADT/Twine.h"
@@ -582,7 +584,7 @@ void SpecialFunctionHandler::trackTaint(ExecutionState &state,
 
   if (source_loc.find("/klee", 0) == std::string::npos) {
     std::string log_message = source_loc + " : " + type + " : " + res + "\n";
-    klee_log_taint("%s", log_message.c_str());
+    EventLog::log(EventKind::Taint, state.getID(), std::move(log_message));
   }
 }
 
@@ -609,7 +611,7 @@ void SpecialFunctionHandler::trackMemory(ExecutionState &state, KInstruction *ta
 
   std::string width_str = std::to_string(ptr_width);
   std::string log_message = info.str() + "(" + width_str + ")" + "\n";
-  klee_log_memory("%s", log_message.c_str());
+  EventLog::log(EventKind::Memory, state.getID(), std::move(log_message));
 }
 
 void SpecialFunctionHandler::handlePrintExpr(ExecutionState &state,
@@ -619,7 +621,16 @@ void SpecialFunctionHandler::handlePrintExpr(ExecutionState &state,
          "invalid number of arguments to klee_print_expr");
 
   std::string msg_str = readStringAtAddress(state, arguments[0]);
-  llvm::errs() << msg_str << ":" << arguments[1] << "\n";
+  llvm::errs() << msg_str << ":" << arguments[1];
+  if (executor.taintTracker) {
+    // The value is concrete, show the input bytes it depends on instead
+    llvm::errs() << " taint:{";
+    executor.taintTracker->print(
+        llvm::errs(),
+        executor.getOperandTaint(target, 2, state.stack.back()));
+    llvm::errs() << "}";
+  }
+  llvm::errs() << "\n";
 
   std::string Str;
   llvm::raw_string_ostream info(Str);
@@ -642,7 +653,7 @@ void SpecialFunctionHandler::handlePrintExpr(ExecutionState &state,
 
   std::string log_message = "\n[klee:expr] " + msg_str + " : " + res + "\n";
   log_message += "[klee:expr] [var-type]: " + type + "\n";
-  klee_log_expr("%s", log_message.c_str());
+  EventLog::log(EventKind::Expr, state.getID(), std::move(log_message));
 }
 
 void SpecialFunctionHandler::handlePrintStatement(ExecutionState &state,
@@ -651,7 +662,7 @@ void SpecialFunctionHandler::handlePrintStatement(ExecutionState &state,
   assert(arguments.size()==1 &&
          "invalid number of arguments to klee_print_stmt");
   std::string msg_str = readStringAtAddress(state, arguments[0]);
-  klee_log_expr("%s", msg_str.c_str());
+  EventLog::log(EventKind::Expr, state.getID(), std::move(msg_str));
 }
 
 void SpecialFunctionHandler::handleSetForking(ExecutionState &state,
@@ -12,6 +12,7 @@
 #include "ExecutionState.h"
 
 #include "klee/Config/Version.h"
+#include "klee/Expr/ExprUtil.h"
 #include "klee/Module/InstructionInfoTable.h"
 #include "klee/Module/KInstruction.h"
 #include "klee/Module/KModule.h"
@@ -70,6 +71,14 @@ cl::opt<bool> OutputIStats("output-istats", cl::init(true),
                                     "callgrind format (default=true)"),
                            cl::cat(StatsCat));
 
+cl::opt<bool> ExprStats(
+    "expr-stats", cl::init(false),
+    cl::desc("Measure the expression DAG of the constraint sets of all "
+             "states at each stats write, which can be slow with many "
+             "states. Otherwise the constraint columns of run.stats are -1 "
+             "(default=false)"),
+    cl::cat(StatsCat));
+
 cl::opt<std::string> StatsWriteInterval(
     "stats-write-interval", cl::init("1s"),
     cl::desc("Approximate time between stats writes (default=1s)"),
@@ -123,6 +132,10 @@ bool StatsTracker::useIStats() {
   return OutputIStats;
 }
 
+bool StatsTracker::useCallPaths() {
+  return OutputIStats && UseCallPaths;
+}
+
 /// Check for special cases where we statically know an instruction is
 /// uncoverable. Currently the case is an unreachable instruction
 /// following a noreturn call; the instruction is really only there to
@@ -300,6 +313,7 @@ StatsTracker::~StatsTracker() {
     sqlite3_finalize(transactionBeginStmt);
     sqlite3_finalize(transactionEndStmt);
     sqlite3_finalize(insertStmt);
+    sqlite3_finalize(insertKindStmt);
     sqlite3_close(statsFile);
   }
 }
@@ -451,7 +465,13 @@ void StatsTracker::writeStatsHeader() {
              << "ResolveTime INTEGER,"
              << "QueryCexCacheMisses INTEGER,"
              << "QueryCexCacheHits INTEGER,"
-             << "ArrayHashTime INTEGER"
+             << "ArrayHashTime INTEGER,"
+             << "LiveExprs INTEGER,"
+             << "ArrayCacheSize INTEGER,"
+             << "ConstraintExprs INTEGER,"
+             << "ConstraintDepth REAL,"
+             << "ConstraintSharing REAL,"
+             << "MaxUpdateListLength INTEGER"
          << ')';
   char *zErrMsg = nullptr;
   if(sqlite3_exec(statsFile, create.str().c_str(), nullptr, nullptr, &zErrMsg)) {
@@ -484,7 +504,13 @@ void StatsTracker::writeStatsHeader() {
              << "ResolveTime,"
              << "QueryCexCacheMisses,"
              << "QueryCexCacheHits,"
-             << "ArrayHashTime"
+             << "ArrayHashTime,"
+             << "LiveExprs,"
+             << "ArrayCacheSize,"
+             << "ConstraintExprs,"
+             << "ConstraintDepth,"
+             << "ConstraintSharing,"
+             << "MaxUpdateListLength"
          << ") VALUES ("
              << "?,"
              << "?,"
@@ -505,12 +531,35 @@ void StatsTracker::writeStatsHeader() {
              << "?,"
              << "?,"
              << "?,"
+             << "?,"
+             << "?,"
+             << "?,"
+             << "?,"
+             << "?,"
+             << "?,"
              << "? "
          << ')';
 
   if(sqlite3_prepare_v2(statsFile, insert.str().c_str(), -1, &insertStmt, nullptr) != SQLITE_OK) {
     klee_error("Cannot create prepared statement: %s", sqlite3_errmsg(statsFile));
   }
+
+  if (!ExprStats)
+    return;
+
+  // Nodes of each kind in the constraint sets, one row per kind and write
+  if (sqlite3_exec(statsFile,
+                   "CREATE TABLE expr_kinds (WallTime INTEGER, Kind TEXT, "
+                   "Count INTEGER)",
+                   nullptr, nullptr, &zErrMsg)) {
+    klee_error("%s", sqlite3ErrToStringAndFree("ERROR creating table: ", zErrMsg).c_str());
+  }
+  if (sqlite3_prepare_v2(statsFile,
+                         "INSERT OR FAIL INTO expr_kinds (WallTime, Kind, "
+                         "Count) VALUES (?, ?, ?)",
+                         -1, &insertKindStmt, nullptr) != SQLITE_OK) {
+    klee_error("Cannot create prepared statement: %s", sqlite3_errmsg(statsFile));
+  }
 }
 
 time::Span StatsTracker::elapsed() {
@@ -542,10 +591,44 @@ void StatsTracker::writeStatsLine() {
 #else
   sqlite3_bind_int64(insertStmt, 20, -1LL);
 #endif
+  sqlite3_bind_int64(insertStmt, 21, Expr::count);
+  sqlite3_bind_int64(insertStmt, 22, executor.arrayCache.getNumArrays());
+  ExprDAGStats dag;
+  if (ExprStats) {
+    for (const ExecutionState *es : executor.states)
+      for (const ref<Expr> &constraint : es->constraints)
+        dag.add(constraint);
+    sqlite3_bind_int64(insertStmt, 23, dag.getNumNodes());
+    sqlite3_bind_double(insertStmt, 24, dag.getAverageDepth());
+    sqlite3_bind_double(insertStmt, 25, dag.getSharing());
+    sqlite3_bind_int64(insertStmt, 26, dag.getMaxUpdateListLength());
+  } else {
+    sqlite3_bind_int64(insertStmt, 23, -1LL);
+    sqlite3_bind_double(insertStmt, 24, -1.0);
+    sqlite3_bind_double(insertStmt, 25, -1.0);
+    sqlite3_bind_int64(insertStmt, 26, -1LL);
+  }
   int errCode = sqlite3_step(insertStmt);
   if(errCode != SQLITE_DONE) klee_error("Error writing stats data: %s", sqlite3_errmsg(statsFile));
   sqlite3_reset(insertStmt);
 
+  if (ExprStats) {
+    const auto wallTime = elapsed().toMicroseconds();
+    for (const auto &kind : dag.getKinds()) {
+      std::string name;
+      llvm::raw_string_ostream os(name);
+      Expr::printKind(os, kind.first);
+      os.flush();
+      sqlite3_bind_int64(insertKindStmt, 1, wallTime);
+      sqlite3_bind_text(insertKindStmt, 2, name.c_str(), -1, SQLITE_TRANSIENT);
+      sqlite3_bind_int64(insertKindStmt, 3, kind.second);
+      errCode = sqlite3_step(insertKindStmt);
+      if (errCode != SQLITE_DONE)
+        klee_error("Error writing stats data: %s", sqlite3_errmsg(statsFile));
+      sqlite3_reset(insertKindStmt);
+    }
+  }
+
   statsWriteCount++;
   if(statsWriteCount == statsCommitEvery) {
     errCode = sqlite3_step(transactionEndStmt);
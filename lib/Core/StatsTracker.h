@@ -44,6 +44,7 @@ namespace klee {
     ::sqlite3_stmt *transactionBeginStmt = nullptr;
     ::sqlite3_stmt *transactionEndStmt = nullptr;
     ::sqlite3_stmt *insertStmt = nullptr;
+    ::sqlite3_stmt *insertKindStmt = nullptr;
     std::uint32_t statsCommitEvery;
     std::uint32_t statsWriteCount = 0;
     time::Point startWallTime;
@@ -58,6 +59,9 @@ namespace klee {
   public:
     static bool useStatistics();
     static bool useIStats();
+    /// Whether stack frames get a call path node (--output-istats and
+    /// --use-call-paths)
+    static bool useCallPaths();
 
   private:
     void updateStateStatistics(uint64_t addend);
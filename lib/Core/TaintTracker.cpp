@@ -0,0 +1,83 @@
+//===-- TaintTracker.cpp ----------------------------------------*- C++ -*-===//
+//
+//                     The KLEE Symbolic Virtual Machine
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "TaintTracker.h"
+
+#include "klee/Module/InstructionInfoTable.h"
+#include "klee/Module/KInstruction.h"
+
+#include "llvm/Support/raw_ostream.h"
+
+#include <algorithm>
+#include <iterator>
+
+using namespace klee;
+
+TaintTracker::TaintTracker() { intern({}); }
+
+TaintSet TaintTracker::intern(std::vector<std::uint32_t> &&labels) {
+  auto it = setIds.emplace(labels, sets.size());
+  if (it.second)
+    sets.push_back(std::move(labels));
+  return it.first->second;
+}
+
+TaintSet TaintTracker::label(const std::string &object, std::uint32_t offset) {
+  auto key = std::make_pair(index.getObject(object, offset + 1), offset);
+  auto it = labelSets.find(key);
+  if (it != labelSets.end())
+    return it->second;
+  std::uint32_t label = labels.size();
+  labels.push_back(key);
+  TaintSet set = intern({label});
+  labelSets.emplace(key, set);
+  return set;
+}
+
+TaintSet TaintTracker::join(TaintSet a, TaintSet b) {
+  if (a == b || !b)
+    return a;
+  if (!a)
+    return b;
+  if (a > b)
+    std::swap(a, b);
+  std::uint64_t key = (std::uint64_t(a) << 32) | b;
+  auto it = joins.find(key);
+  if (it != joins.end())
+    return it->second;
+
+  std::vector<std::uint32_t> merged;
+  std::set_union(sets[a].begin(), sets[a].end(), sets[b].begin(),
+                 sets[b].end(), std::back_inserter(merged));
+  TaintSet set = intern(std::move(merged));
+  joins.emplace(key, set);
+  return set;
+}
+
+void TaintTracker::reach(const KInstruction *ki, TaintSet taint) {
+  if (!taint)
+    return;
+  const InstructionInfo &info = *ki->info;
+  std::uint64_t key = (std::uint64_t(info.assemblyLine) << 32) | taint;
+  if (!reached.insert(key).second)
+    return;
+  DependencyIndex::Site &site =
+      index.getSite(info.assemblyLine, info.file, info.line);
+  for (std::uint32_t label : sets[taint])
+    site.bytes[labels[label].first].insert(labels[label].second);
+}
+
+void TaintTracker::print(llvm::raw_ostream &os, TaintSet taint) const {
+  const char *separator = "";
+  for (std::uint32_t label : sets[taint]) {
+    os << separator << index.getObjects()[labels[label].first] << "["
+       << labels[label].second << "]";
+    separator = " ";
+  }
+}
@@ -0,0 +1,82 @@
+//===-- TaintTracker.h ------------------------------------------*- C++ -*-===//
+//
+//                     The KLEE Symbolic Virtual Machine
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+/**
+ * @file TaintTracker.h
+ * @brief Shadow taint labels for --shadow-taint
+ *
+ * In shadow taint mode, inputs stay concrete and every input byte gets a
+ * label instead. Registers (Cell::taint) and memory bytes (ObjectState)
+ * carry the id of an interned set of labels, 0 standing for the empty
+ * set, so propagating taint through an instruction is a memoized union of
+ * small integers rather than the construction of expressions.
+ */
+
+#ifndef KLEE_TAINTTRACKER_H
+#define KLEE_TAINTTRACKER_H
+
+#include "klee/Support/DependencyIndex.h"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace llvm {
+class raw_ostream;
+}
+
+namespace klee {
+struct KInstruction;
+
+/// Id of an interned set of taint labels, 0 if untainted
+typedef std::uint32_t TaintSet;
+
+class TaintTracker {
+  /// Labels by id: an object and byte offset in the index
+  std::vector<std::pair<std::uint32_t, std::uint32_t>> labels;
+  std::map<std::pair<std::uint32_t, std::uint32_t>, TaintSet> labelSets;
+
+  /// Sorted label ids of the interned sets, the empty set first
+  std::vector<std::vector<std::uint32_t>> sets;
+  std::map<std::vector<std::uint32_t>, TaintSet> setIds;
+  std::unordered_map<std::uint64_t, TaintSet> joins;
+
+  /// Taint sets already added to the index at an instruction
+  std::unordered_set<std::uint64_t> reached;
+
+  /// Input bytes reaching each instruction
+  DependencyIndex index;
+
+  TaintSet intern(std::vector<std::uint32_t> &&labels);
+
+public:
+  TaintTracker();
+
+  /// The set of the single label for a byte of an input object
+  TaintSet label(const std::string &object, std::uint32_t offset);
+
+  /// Union of two sets
+  TaintSet join(TaintSet a, TaintSet b);
+
+  /// Record that the operands of an instruction carry the given taint
+  void reach(const KInstruction *ki, TaintSet taint);
+
+  /// Print the bytes of a set, e.g. "x[0] x[3]"
+  void print(llvm::raw_ostream &os, TaintSet taint) const;
+
+  /// Input bytes that reached each instruction, by its line in assembly.ll
+  const DependencyIndex &getIndex() const { return index; }
+};
+} // namespace klee
+
+#endif /* KLEE_TAINTTRACKER_H */
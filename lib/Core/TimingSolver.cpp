@@ -10,11 +10,13 @@
 #include "TimingSolver.h"
 
 #include "ExecutionState.h"
+#include "QueryTimeHistogram.h"
 
 #include "klee/Config/Version.h"
 #include "klee/Statistics/Statistics.h"
 #include "klee/Statistics/TimerStatIncrementer.h"
 #include "klee/Solver/Solver.h"
+#include "klee/Solver/SolverStats.h"
 
 #include "CoreStats.h"
 
@@ -33,13 +35,14 @@ bool TimingSolver::evaluate(const ConstraintSet &constraints, ref<Expr> expr,
   }
 
   TimerStatIncrementer timer(stats::solverTime);
+  CoreQueries core = countCoreQueries();
 
   if (simplifyExprs)
     expr = ConstraintManager::simplifyExpr(constraints, expr);
 
   bool success = solver->evaluate(Query(constraints, expr), result);
 
-  metaData.queryCost += timer.delta();
+  addQueryTime(metaData, timer.delta(), core);
 
   return success;
 }
@@ -53,13 +56,14 @@ bool TimingSolver::mustBeTrue(const ConstraintSet &constraints, ref<Expr> expr,
   }
 
   TimerStatIncrementer timer(stats::solverTime);
+  CoreQueries core = countCoreQueries();
 
   if (simplifyExprs)
     expr = ConstraintManager::simplifyExpr(constraints, expr);
 
   bool success = solver->mustBeTrue(Query(constraints, expr), result);
 
-  metaData.queryCost += timer.delta();
+  addQueryTime(metaData, timer.delta(), core);
 
   return success;
 }
@@ -97,13 +101,14 @@ bool TimingSolver::getValue(const ConstraintSet &constraints, ref<Expr> expr,
   }
   
   TimerStatIncrementer timer(stats::solverTime);
+  CoreQueries core = countCoreQueries();
 
   if (simplifyExprs)
     expr = ConstraintManager::simplifyExpr(constraints, expr);
 
   bool success = solver->getValue(Query(constraints, expr), result);
 
-  metaData.queryCost += timer.delta();
+  addQueryTime(metaData, timer.delta(), core);
 
   return success;
 }
@@ -120,6 +125,7 @@ bool TimingSolver::getInitialValues(
   bool success = solver->getInitialValues(
       Query(constraints, ConstantExpr::alloc(0, Expr::Bool)), objects, result);
 
+  // Test generation queries do not bear on the timeout of path queries
   metaData.queryCost += timer.delta();
 
   return success;
@@ -129,7 +135,31 @@ std::pair<ref<Expr>, ref<Expr>>
 TimingSolver::getRange(const ConstraintSet &constraints, ref<Expr> expr,
                        SolverQueryMetaData &metaData) {
   TimerStatIncrementer timer(stats::solverTime);
+  CoreQueries core = countCoreQueries();
   auto result = solver->getRange(Query(constraints, expr));
-  metaData.queryCost += timer.delta();
+  addQueryTime(metaData, timer.delta(), core);
   return result;
 }
+
+TimingSolver::CoreQueries TimingSolver::countCoreQueries() const {
+  return {stats::queries, stats::queryTime};
+}
+
+void TimingSolver::addQueryTime(SolverQueryMetaData &metaData, time::Span t,
+                                const CoreQueries &before) {
+  metaData.queryCost += t;
+  if (!queryTimes)
+    return;
+
+  // Queries answered by the caches never reach the core solver, and would
+  // drag the distribution towards zero
+  CoreQueries after = countCoreQueries();
+  std::uint64_t count = after.count - before.count;
+  if (count == 0)
+    return;
+  // The core solver times its queries only in total, so a query that
+  // reached it several times (e.g. evaluate) records their mean
+  time::Span mean = time::microseconds((after.time - before.time) / count);
+  for (std::uint64_t i = 0; i < count; ++i)
+    queryTimes->add(mean);
+}
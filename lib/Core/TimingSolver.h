@@ -15,11 +15,13 @@
 #include "klee/Solver/Solver.h"
 #include "klee/System/Time.h"
 
+#include <cstdint>
 #include <memory>
 #include <vector>
 
 namespace klee {
 class ConstraintSet;
+class QueryTimeHistogram;
 class Solver;
 
 /// TimingSolver - A simple class which wraps a solver and handles
@@ -28,6 +30,8 @@ class TimingSolver {
 public:
   std::unique_ptr<Solver> solver;
   bool simplifyExprs;
+  /// Records the time of the path queries that reach the core solver, if set
+  QueryTimeHistogram *queryTimes = nullptr;
 
 public:
   /// TimingSolver - Construct a new timing solver.
@@ -70,6 +74,18 @@ public:
   std::pair<ref<Expr>, ref<Expr>> getRange(const ConstraintSet &,
                                            ref<Expr> query,
                                            SolverQueryMetaData &metaData);
+
+private:
+  /// Number and total time (in microseconds) of the core solver queries
+  struct CoreQueries {
+    std::uint64_t count;
+    std::uint64_t time;
+  };
+
+  CoreQueries countCoreQueries() const;
+
+  void addQueryTime(SolverQueryMetaData &metaData, time::Span t,
+                    const CoreQueries &before);
 };
 }
 
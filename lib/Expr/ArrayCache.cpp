@@ -14,6 +14,34 @@ ArrayCache::~ArrayCache() {
        ai != e; ++ai) {
     delete *ai;
   }
+  // Interned arrays still referenced are freed by their last update list
+  for (const Array *array : internedArrays) {
+    if (array->refCount == 0)
+      delete array;
+    else
+      array->cache = nullptr;
+  }
+}
+
+std::size_t ConstantArrayHashFn::operator()(const Array *array) const {
+  std::size_t res = array->size;
+  res = (res * Expr::MAGIC_HASH_CONSTANT) + array->domain;
+  res = (res * Expr::MAGIC_HASH_CONSTANT) + array->range;
+  for (const ref<ConstantExpr> &value : array->constantValues)
+    res = (res * Expr::MAGIC_HASH_CONSTANT) + value->hash();
+  return res;
+}
+
+bool ConstantArrayCmpFn::operator()(const Array *array1,
+                                    const Array *array2) const {
+  if (array1->size != array2->size || array1->domain != array2->domain ||
+      array1->range != array2->range)
+    return false;
+  for (unsigned i = 0; i < array1->size; ++i)
+    if (array1->constantValues[i]->getAPValue() !=
+        array2->constantValues[i]->getAPValue())
+      return false;
+  return true;
 }
 
 const Array *
@@ -44,4 +72,32 @@ ArrayCache::CreateArray(const std::string &_name, uint64_t _size,
     return array;
   }
 }
+
+const Array *ArrayCache::CreateConstantArray(
+    const std::string &_name, const ref<ConstantExpr> *constantValuesBegin,
+    const ref<ConstantExpr> *constantValuesEnd, Expr::Width _domain,
+    Expr::Width _range) {
+  Array *array = new Array(_name, constantValuesEnd - constantValuesBegin,
+                           constantValuesBegin, constantValuesEnd, _domain,
+                           _range);
+  assert(array->isConstantArray() && "interning a symbolic array");
+  auto success = internedArrays.insert(array);
+  if (!success.second) {
+    delete array;
+    return *success.first;
+  }
+  array->interned = true;
+  array->cache = this;
+  return array;
+}
+
+void ArrayCache::release(const Array *array) {
+  assert(array->interned && array->refCount == 0 &&
+         "releasing a referenced array");
+  auto it = internedArrays.find(array);
+  assert(it != internedArrays.end() && *it == array &&
+         "array not interned in this cache");
+  internedArrays.erase(it);
+  delete array;
+}
 }
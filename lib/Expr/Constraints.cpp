@@ -9,6 +9,7 @@
 
 #include "klee/Expr/Constraints.h"
 
+#include "klee/Expr/ExprHashMap.h"
 #include "klee/Expr/ExprVisitor.h"
 #include "klee/Module/KModule.h"
 #include "klee/Support/OptionCategories.h"
@@ -16,7 +17,9 @@
 #include "llvm/IR/Function.h"
 #include "llvm/Support/CommandLine.h"
 
+#include <algorithm>
 #include <map>
+#include <set>
 
 using namespace klee;
 
@@ -27,8 +30,160 @@ llvm::cl::opt<bool> RewriteEqualities(
                    "constant is added (default=true)"),
     llvm::cl::init(true),
     llvm::cl::cat(SolvingCat));
+
+llvm::cl::opt<unsigned> CompactConstraints(
+    "compact-constraints",
+    llvm::cl::desc("Compact the constraint set (drop duplicate and implied "
+                   "constraints, merge range constraints on the same "
+                   "expression) every time it grows by this many "
+                   "constraints (0=off, default=64)"),
+    llvm::cl::init(64),
+    llvm::cl::cat(SolvingCat));
+
+/// Closed interval [lo, hi] a constraint restricts an expression to, in the
+/// unsigned or signed domain of that expression.
+struct Bound {
+  ref<Expr> expr;
+  bool isSigned;
+  llvm::APInt lo, hi;
+
+  bool empty() const { return isSigned ? hi.slt(lo) : hi.ult(lo); }
+
+  bool contains(const Bound &b) const {
+    return isSigned ? lo.sle(b.lo) && b.hi.sle(hi)
+                    : lo.ule(b.lo) && b.hi.ule(hi);
+  }
+
+  void intersect(const Bound &b) {
+    if (isSigned) {
+      lo = lo.slt(b.lo) ? b.lo : lo;
+      hi = hi.sgt(b.hi) ? b.hi : hi;
+    } else {
+      lo = lo.ult(b.lo) ? b.lo : lo;
+      hi = hi.ugt(b.hi) ? b.hi : hi;
+    }
+  }
+};
+
+/// Match constraints of the form `c op e` or `e op c` for a constant c and
+/// an (un)signed comparison op, possibly negated, as well as `c == e`.
+bool getBound(const ref<Expr> &constraint, Bound &bound) {
+  ref<Expr> e = constraint;
+  bool negated = false;
+  if (const EqExpr *ee = dyn_cast<EqExpr>(e)) {
+    const ConstantExpr *ce = dyn_cast<ConstantExpr>(ee->left);
+    if (!ce || isa<ConstantExpr>(ee->right))
+      return false;
+    if (ee->right->getWidth() != Expr::Bool) {
+      bound.expr = ee->right;
+      bound.isSigned = false;
+      bound.lo = bound.hi = ce->getAPValue();
+      return true;
+    }
+    if (!ce->isFalse())
+      return false;
+    e = ee->right;
+    negated = true;
+  }
+
+  bool isSigned, strict;
+  switch (e->getKind()) {
+  case Expr::Ult: isSigned = false; strict = true; break;
+  case Expr::Ule: isSigned = false; strict = false; break;
+  case Expr::Slt: isSigned = true; strict = true; break;
+  case Expr::Sle: isSigned = true; strict = false; break;
+  default:
+    return false;
+  }
+
+  const BinaryExpr *be = cast<BinaryExpr>(e);
+  const ConstantExpr *ce;
+  bool upper; // the constant bounds the expression from above
+  if ((ce = dyn_cast<ConstantExpr>(be->right)) && !isa<ConstantExpr>(be->left)) {
+    bound.expr = be->left;
+    upper = true;
+  } else if ((ce = dyn_cast<ConstantExpr>(be->left)) &&
+             !isa<ConstantExpr>(be->right)) {
+    bound.expr = be->right;
+    upper = false;
+  } else {
+    return false;
+  }
+  // !(e < c) is c <= e, !(e <= c) is c < e, and vice versa
+  if (negated) {
+    upper = !upper;
+    strict = !strict;
+  }
+
+  unsigned width = ce->getWidth();
+  llvm::APInt c = ce->getAPValue();
+  llvm::APInt min = isSigned ? llvm::APInt::getSignedMinValue(width)
+                             : llvm::APInt::getMinValue(width);
+  llvm::APInt max = isSigned ? llvm::APInt::getSignedMaxValue(width)
+                             : llvm::APInt::getMaxValue(width);
+  bound.isSigned = isSigned;
+  if (upper) {
+    if (strict) {
+      if (c == min)
+        return false; // unsatisfiable, leave it to the solver
+      --c;
+    }
+    bound.lo = min;
+    bound.hi = c;
+  } else {
+    if (strict) {
+      if (c == max)
+        return false;
+      ++c;
+    }
+    bound.lo = c;
+    bound.hi = max;
+  }
+  return true;
+}
+
+/// Build the constraints equivalent to a (non-empty) bound
+void buildBound(const Bound &b, std::vector<ref<Expr>> &out) {
+  unsigned width = b.expr->getWidth();
+  if (b.lo == b.hi) {
+    out.push_back(EqExpr::create(ConstantExpr::alloc(b.lo), b.expr));
+    return;
+  }
+  if (b.isSigned) {
+    if (!b.lo.isMinSignedValue())
+      out.push_back(SleExpr::create(ConstantExpr::alloc(b.lo), b.expr));
+    if (!b.hi.isMaxSignedValue())
+      out.push_back(SleExpr::create(b.expr, ConstantExpr::alloc(b.hi)));
+  } else {
+    if (!b.lo.isMinValue())
+      out.push_back(UleExpr::create(ConstantExpr::alloc(b.lo), b.expr));
+    if (b.hi != llvm::APInt::getMaxValue(width))
+      out.push_back(UleExpr::create(b.expr, ConstantExpr::alloc(b.hi)));
+  }
+}
+
+using BoundKey = std::pair<ref<Expr>, bool>;
+
+/// Collect the disjuncts of a (nested) disjunction
+void getDisjuncts(const ref<Expr> &e, std::vector<ref<Expr>> &out) {
+  if (const OrExpr *oe = dyn_cast<OrExpr>(e)) {
+    getDisjuncts(oe->left, out);
+    getDisjuncts(oe->right, out);
+  } else {
+    out.push_back(e);
+  }
+}
 } // namespace
 
+struct ConstraintSet::CompactionIndex {
+  /// Constraints of the compacted set, and the ones dropped as redundant
+  ExprHashSet constraints;
+  /// Range known for each expression
+  std::map<BoundKey, Bound> bounds;
+  /// Constraints of the compacted set that restrict each expression
+  std::map<BoundKey, std::vector<ref<Expr>>> boundConstraints;
+};
+
 class ExprReplaceVisitor : public ExprVisitor {
 private:
   ref<Expr> src, dst;
@@ -86,6 +241,11 @@ bool ConstraintManager::rewriteConstraints(ExprVisitor &visitor) {
     }
   }
 
+  // Compacting resumes where it stopped, unless constraints were rewritten
+  if (!changed) {
+    constraints.compactedSize = old.compactedSize;
+    constraints.compactionIndex = std::move(old.compactionIndex);
+  }
   return changed;
 }
 
@@ -158,6 +318,114 @@ void ConstraintManager::addConstraintInternal(const ref<Expr> &e) {
 void ConstraintManager::addConstraint(const ref<Expr> &e) {
   ref<Expr> simplified = simplifyExpr(constraints, e);
   addConstraintInternal(simplified);
+
+  if (CompactConstraints &&
+      constraints.size() >= constraints.compactedSize + CompactConstraints)
+    compact();
+}
+
+void ConstraintManager::compact() {
+  ConstraintSet::constraints_ty &cs = constraints.constraints;
+  std::shared_ptr<ConstraintSet::CompactionIndex> &index =
+      constraints.compactionIndex;
+  if (!index || constraints.compactedSize > cs.size()) {
+    index = std::make_shared<ConstraintSet::CompactionIndex>();
+    constraints.compactedSize = 0;
+  } else if (index.use_count() > 1) {
+    index = std::make_shared<ConstraintSet::CompactionIndex>(*index);
+  }
+  std::size_t begin = constraints.compactedSize;
+
+  // Drop trivially true and syntactically duplicate constraints
+  ConstraintSet::constraints_ty added;
+  for (std::size_t i = begin; i < cs.size(); ++i) {
+    if (isa<ConstantExpr>(cs[i]) || !index->constraints.insert(cs[i]).second)
+      continue;
+    added.push_back(cs[i]);
+  }
+
+  // Intersect the new ranges with the ones already known
+  std::map<BoundKey, std::vector<ref<Expr>>> addedBounds;
+  for (const auto &c : added) {
+    Bound b;
+    if (!getBound(c, b))
+      continue;
+    BoundKey key(b.expr, b.isSigned);
+    auto it = index->bounds.find(key);
+    if (it == index->bounds.end())
+      index->bounds.emplace(key, b);
+    else
+      it->second.intersect(b);
+    addedBounds[key].push_back(c);
+  }
+
+  // Ranges restricted by more than one constraint are merged, the older
+  // constraints on them are removed
+  ExprHashSet removed;
+  std::map<BoundKey, ref<Expr>> mergedAt;
+  for (const auto &entry : addedBounds) {
+    std::vector<ref<Expr>> &old = index->boundConstraints[entry.first];
+    const Bound &merged = index->bounds.find(entry.first)->second;
+    // Contradictory ranges make the state infeasible, leave them alone
+    if (old.size() + entry.second.size() == 1 || merged.empty()) {
+      old.insert(old.end(), entry.second.begin(), entry.second.end());
+      continue;
+    }
+    removed.insert(old.begin(), old.end());
+    old.clear();
+    buildBound(merged, old);
+    index->constraints.insert(old.begin(), old.end());
+    mergedAt.emplace(entry.first, entry.second.back());
+  }
+
+  // A disjunction is implied if one of its disjuncts is a constraint itself
+  // or holds on the whole range known for its expression
+  auto isImplied = [&](const ref<Expr> &c) {
+    if (!isa<OrExpr>(c))
+      return false;
+    std::vector<ref<Expr>> disjuncts;
+    getDisjuncts(c, disjuncts);
+    for (const auto &d : disjuncts) {
+      if (index->constraints.count(d))
+        return true;
+      Bound db;
+      if (!getBound(d, db))
+        continue;
+      auto it = index->bounds.find(BoundKey(db.expr, db.isSigned));
+      if (it != index->bounds.end() && !it->second.empty() &&
+          db.contains(it->second))
+        return true;
+    }
+    return false;
+  };
+
+  // Rebuild the new part of the set, emitting merged ranges where the last
+  // constraint on the expression is
+  ConstraintSet::constraints_ty result;
+  for (const auto &c : added) {
+    Bound b;
+    if (getBound(c, b)) {
+      BoundKey key(b.expr, b.isSigned);
+      auto it = mergedAt.find(key);
+      if (it == mergedAt.end())
+        result.push_back(c);
+      else if (it->second == c)
+        buildBound(index->bounds.find(key)->second, result);
+      continue;
+    }
+    if (!isImplied(c))
+      result.push_back(c);
+  }
+
+  cs.resize(begin);
+  if (!removed.empty())
+    cs.erase(std::remove_if(cs.begin(), cs.end(),
+                            [&](const ref<Expr> &c) {
+                              return removed.count(c) != 0;
+                            }),
+             cs.end());
+  cs.insert(cs.end(), result.begin(), result.end());
+  constraints.compactedSize = cs.size();
 }
 
 ConstraintManager::ConstraintManager(ConstraintSet &_constraints)
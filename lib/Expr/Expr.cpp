@@ -16,6 +16,8 @@
 // Core. If we need to do arithmetic, we probably want to use APInt.
 #include "klee/Support/IntEvaluation.h"
 
+#include "llvm/ADT/APFloat.h"
+#include "llvm/ADT/APSInt.h"
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/Hashing.h"
 #if LLVM_VERSION_CODE >= LLVM_VERSION(13, 0)
@@ -144,6 +146,11 @@ void Expr::printKind(llvm::raw_ostream &os, Kind k) {
     X(Extract);
     X(ZExt);
     X(SExt);
+    X(FPConvert);
+    X(FPToSI);
+    X(FPToUI);
+    X(SIToFP);
+    X(UIToFP);
     X(Add);
     X(Sub);
     X(Mul);
@@ -168,6 +175,13 @@ void Expr::printKind(llvm::raw_ostream &os, Kind k) {
     X(Sle);
     X(Sgt);
     X(Sge);
+    X(FAdd);
+    X(FSub);
+    X(FMul);
+    X(FDiv);
+    X(FOEq);
+    X(FOLt);
+    X(FOLe);
 #undef X
   default:
     assert(0 && "invalid kind");
@@ -209,6 +223,13 @@ unsigned CastExpr::computeHash() {
   return hashValue;
 }
 
+unsigned FPCastExpr::computeHash() {
+  unsigned res = getWidth() * Expr::MAGIC_HASH_CONSTANT;
+  res ^= getKind() * Expr::MAGIC_HASH_CONSTANT;
+  hashValue = res ^ src->hash() * Expr::MAGIC_HASH_CONSTANT;
+  return hashValue;
+}
+
 unsigned ExtractExpr::computeHash() {
   unsigned res = offset * Expr::MAGIC_HASH_CONSTANT;
   res ^= getWidth() * Expr::MAGIC_HASH_CONSTANT;
@@ -275,6 +296,11 @@ ref<Expr> Expr::createFromKind(Kind k, std::vector<CreateArg> args) {
 
       CAST_EXPR_CASE(ZExt);
       CAST_EXPR_CASE(SExt);
+      CAST_EXPR_CASE(FPConvert);
+      CAST_EXPR_CASE(FPToSI);
+      CAST_EXPR_CASE(FPToUI);
+      CAST_EXPR_CASE(SIToFP);
+      CAST_EXPR_CASE(UIToFP);
       
       BINARY_EXPR_CASE(Add);
       BINARY_EXPR_CASE(Sub);
@@ -300,6 +326,14 @@ ref<Expr> Expr::createFromKind(Kind k, std::vector<CreateArg> args) {
       BINARY_EXPR_CASE(Sle);
       BINARY_EXPR_CASE(Sgt);
       BINARY_EXPR_CASE(Sge);
+
+      BINARY_EXPR_CASE(FAdd);
+      BINARY_EXPR_CASE(FSub);
+      BINARY_EXPR_CASE(FMul);
+      BINARY_EXPR_CASE(FDiv);
+      BINARY_EXPR_CASE(FOEq);
+      BINARY_EXPR_CASE(FOLt);
+      BINARY_EXPR_CASE(FOLe);
   }
 }
 
@@ -513,6 +547,88 @@ ref<ConstantExpr> ConstantExpr::Sge(const ref<ConstantExpr> &RHS) {
   return ConstantExpr::alloc(value.sge(RHS->value), Expr::Bool);
 }
 
+static const fltSemantics &getFPSemantics(Expr::Width w) {
+  assert(ConstantExpr::isFloatingPointWidth(w) && "invalid floating point width");
+  return w == Expr::Int32 ? APFloat::IEEEsingle() : APFloat::IEEEdouble();
+}
+
+static APFloat getAPFloat(const ConstantExpr &ce) {
+  return APFloat(getFPSemantics(ce.getWidth()), ce.getAPValue());
+}
+
+ref<ConstantExpr> ConstantExpr::FAdd(const ref<ConstantExpr> &RHS) {
+  APFloat res = getAPFloat(*this);
+  res.add(getAPFloat(*RHS), APFloat::rmNearestTiesToEven);
+  return ConstantExpr::alloc(res);
+}
+
+ref<ConstantExpr> ConstantExpr::FSub(const ref<ConstantExpr> &RHS) {
+  APFloat res = getAPFloat(*this);
+  res.subtract(getAPFloat(*RHS), APFloat::rmNearestTiesToEven);
+  return ConstantExpr::alloc(res);
+}
+
+ref<ConstantExpr> ConstantExpr::FMul(const ref<ConstantExpr> &RHS) {
+  APFloat res = getAPFloat(*this);
+  res.multiply(getAPFloat(*RHS), APFloat::rmNearestTiesToEven);
+  return ConstantExpr::alloc(res);
+}
+
+ref<ConstantExpr> ConstantExpr::FDiv(const ref<ConstantExpr> &RHS) {
+  APFloat res = getAPFloat(*this);
+  res.divide(getAPFloat(*RHS), APFloat::rmNearestTiesToEven);
+  return ConstantExpr::alloc(res);
+}
+
+ref<ConstantExpr> ConstantExpr::FOEq(const ref<ConstantExpr> &RHS) {
+  APFloat::cmpResult res = getAPFloat(*this).compare(getAPFloat(*RHS));
+  return ConstantExpr::alloc(res == APFloat::cmpEqual, Expr::Bool);
+}
+
+ref<ConstantExpr> ConstantExpr::FOLt(const ref<ConstantExpr> &RHS) {
+  APFloat::cmpResult res = getAPFloat(*this).compare(getAPFloat(*RHS));
+  return ConstantExpr::alloc(res == APFloat::cmpLessThan, Expr::Bool);
+}
+
+ref<ConstantExpr> ConstantExpr::FOLe(const ref<ConstantExpr> &RHS) {
+  APFloat::cmpResult res = getAPFloat(*this).compare(getAPFloat(*RHS));
+  return ConstantExpr::alloc(
+      res == APFloat::cmpLessThan || res == APFloat::cmpEqual, Expr::Bool);
+}
+
+ref<ConstantExpr> ConstantExpr::FPConvert(Width W) {
+  APFloat res = getAPFloat(*this);
+  bool losesInfo = false;
+  res.convert(getFPSemantics(W), APFloat::rmNearestTiesToEven, &losesInfo);
+  return ConstantExpr::alloc(res);
+}
+
+ref<ConstantExpr> ConstantExpr::FPToSI(Width W) {
+  APSInt res(W, /*isUnsigned=*/false);
+  bool isExact = true;
+  getAPFloat(*this).convertToInteger(res, APFloat::rmTowardZero, &isExact);
+  return ConstantExpr::alloc(res);
+}
+
+ref<ConstantExpr> ConstantExpr::FPToUI(Width W) {
+  APSInt res(W, /*isUnsigned=*/true);
+  bool isExact = true;
+  getAPFloat(*this).convertToInteger(res, APFloat::rmTowardZero, &isExact);
+  return ConstantExpr::alloc(res);
+}
+
+ref<ConstantExpr> ConstantExpr::SIToFP(Width W) {
+  APFloat res(getFPSemantics(W));
+  res.convertFromAPInt(value, /*IsSigned=*/true, APFloat::rmNearestTiesToEven);
+  return ConstantExpr::alloc(res);
+}
+
+ref<ConstantExpr> ConstantExpr::UIToFP(Width W) {
+  APFloat res(getFPSemantics(W));
+  res.convertFromAPInt(value, /*IsSigned=*/false, APFloat::rmNearestTiesToEven);
+  return ConstantExpr::alloc(res);
+}
+
 /***/
 
 ref<Expr>  NotOptimizedExpr::create(ref<Expr> src) {
@@ -1232,3 +1348,46 @@ CMPCREATE(UltExpr, Ult)
 CMPCREATE(UleExpr, Ule)
 CMPCREATE(SltExpr, Slt)
 CMPCREATE(SleExpr, Sle)
+
+/***/
+
+#define FPCASTCREATE(_e_op, _op)                                        \
+ref<Expr> _e_op ::create(const ref<Expr> &e, Width w) {                 \
+  if (ConstantExpr *CE = dyn_cast<ConstantExpr>(e))                     \
+    return CE->_op(w);                                                  \
+  return _e_op::alloc(e, w);                                            \
+}
+
+ref<Expr> FPConvertExpr::create(const ref<Expr> &e, Width w) {
+  assert(ConstantExpr::isFloatingPointWidth(e->getWidth()) &&
+         "invalid floating point width");
+  if (w == e->getWidth())
+    return e;
+  if (ConstantExpr *CE = dyn_cast<ConstantExpr>(e))
+    return CE->FPConvert(w);
+  return FPConvertExpr::alloc(e, w);
+}
+
+FPCASTCREATE(FPToSIExpr, FPToSI)
+FPCASTCREATE(FPToUIExpr, FPToUI)
+FPCASTCREATE(SIToFPExpr, SIToFP)
+FPCASTCREATE(UIToFPExpr, UIToFP)
+
+#define FPBCREATE(_e_op, _op)                                               \
+ref<Expr> _e_op ::create(const ref<Expr> &l, const ref<Expr> &r) {          \
+  assert(l->getWidth()==r->getWidth() && "type mismatch");                  \
+  assert(ConstantExpr::isFloatingPointWidth(l->getWidth()) &&               \
+         "invalid floating point width");                                   \
+  if (ConstantExpr *cl = dyn_cast<ConstantExpr>(l))                         \
+    if (ConstantExpr *cr = dyn_cast<ConstantExpr>(r))                       \
+      return cl->_op(cr);                                                   \
+  return _e_op::alloc(l, r);                                                \
+}
+
+FPBCREATE(FAddExpr, FAdd)
+FPBCREATE(FSubExpr, FSub)
+FPBCREATE(FMulExpr, FMul)
+FPBCREATE(FDivExpr, FDiv)
+FPBCREATE(FOEqExpr, FOEq)
+FPBCREATE(FOLtExpr, FOLt)
+FPBCREATE(FOLeExpr, FOLe)
@@ -10,6 +10,7 @@
 #include "klee/Expr/ExprSMTLIBPrinter.h"
 #include "klee/Support/Casting.h"
 
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/ErrorHandling.h"
 
@@ -55,7 +56,7 @@ namespace klee {
 
 ExprSMTLIBPrinter::ExprSMTLIBPrinter()
     : usedArrays(), o(NULL), query(NULL), p(NULL), haveConstantArray(false),
-      logicToUse(QF_AUFBV),
+      haveFloatingPoint(false), logicToUse(QF_AUFBV),
       humanReadable(ExprSMTLIBOptions::humanReadableSMTLIB),
       smtlibBoolOptions(), arraysToCallGetValueOn(NULL) {
   setConstantDisplayMode(ExprSMTLIBOptions::argConstantDisplayMode);
@@ -85,6 +86,7 @@ void ExprSMTLIBPrinter::reset() {
   seenExprs.clear();
   usedArrays.clear();
   haveConstantArray = false;
+  haveFloatingPoint = false;
 
   /* Clear the PRODUCE_MODELS option if it was automatically set.
    * We need to do this because the next query might not need the
@@ -261,6 +263,21 @@ void ExprSMTLIBPrinter::printFullExpression(
     printAShrExpr(cast<AShrExpr>(e));
     return;
 
+  case Expr::FPConvert:
+  case Expr::FPToSI:
+  case Expr::FPToUI:
+  case Expr::SIToFP:
+  case Expr::UIToFP:
+  case Expr::FAdd:
+  case Expr::FSub:
+  case Expr::FMul:
+  case Expr::FDiv:
+  case Expr::FOEq:
+  case Expr::FOLt:
+  case Expr::FOLe:
+    printFPExpr(e);
+    return;
+
   default:
     /* The remaining operators (Add,Sub...,Ult,Ule,..)
      * Expect SORT_BITVECTOR arguments
@@ -404,6 +421,93 @@ void ExprSMTLIBPrinter::printAShrExpr(const ref<AShrExpr> &e) {
   *p << ")";
 }
 
+/// Return the (exponent, significand) sizes of the floating point sort used
+/// for values of width w.
+static std::pair<unsigned, unsigned> getFPSortSizes(Expr::Width w) {
+  assert(ConstantExpr::isFloatingPointWidth(w) &&
+         "invalid floating point width");
+  return w == Expr::Int32 ? std::make_pair(8u, 24u) : std::make_pair(11u, 53u);
+}
+
+void ExprSMTLIBPrinter::printAsFloatingPoint(const ref<Expr> &e) {
+  std::pair<unsigned, unsigned> sizes = getFPSortSizes(e->getWidth());
+  *p << "((_ to_fp " << sizes.first << " " << sizes.second << ") ";
+  p->pushIndent();
+  printSeperator();
+  printExpression(e, SORT_BITVECTOR);
+  p->popIndent();
+  printSeperator();
+  *p << ")";
+}
+
+void ExprSMTLIBPrinter::printFPExpr(const ref<Expr> &e) {
+  /* SMT-LIBv2 floating point operations work on a separate FloatingPoint
+   * sort, while KLEE keeps floating point values as IEEE-754 bit patterns.
+   * Operands are reinterpreted with ((_ to_fp eb sb) bv) and floating point
+   * results are converted back with fp.to_ieee_bv (a Z3 extension, as there
+   * is no standard way to do this because NaN has several representations).
+   */
+  bool floatResult = true;
+  const char *rm = "RNE ";
+  std::string op;
+  switch (e->getKind()) {
+  case Expr::FAdd: op = "fp.add"; break;
+  case Expr::FSub: op = "fp.sub"; break;
+  case Expr::FMul: op = "fp.mul"; break;
+  case Expr::FDiv: op = "fp.div"; break;
+  case Expr::FOEq: op = "fp.eq"; floatResult = false; rm = ""; break;
+  case Expr::FOLt: op = "fp.lt"; floatResult = false; rm = ""; break;
+  case Expr::FOLe: op = "fp.leq"; floatResult = false; rm = ""; break;
+  case Expr::FPConvert:
+  case Expr::SIToFP: {
+    std::pair<unsigned, unsigned> sizes = getFPSortSizes(e->getWidth());
+    op = "(_ to_fp " + llvm::utostr(sizes.first) + " " +
+         llvm::utostr(sizes.second) + ")";
+    break;
+  }
+  case Expr::UIToFP: {
+    std::pair<unsigned, unsigned> sizes = getFPSortSizes(e->getWidth());
+    op = "(_ to_fp_unsigned " + llvm::utostr(sizes.first) + " " +
+         llvm::utostr(sizes.second) + ")";
+    break;
+  }
+  case Expr::FPToSI:
+    op = "(_ fp.to_sbv " + llvm::utostr(e->getWidth()) + ")";
+    floatResult = false;
+    rm = "RTZ ";
+    break;
+  case Expr::FPToUI:
+    op = "(_ fp.to_ubv " + llvm::utostr(e->getWidth()) + ")";
+    floatResult = false;
+    rm = "RTZ ";
+    break;
+  default:
+    llvm_unreachable("Conversion from Expr to SMTLIB keyword failed");
+  }
+
+  if (floatResult)
+    *p << "(fp.to_ieee_bv ";
+  *p << "(" << op << " " << rm;
+  p->pushIndent(); // add indent for recursive call
+
+  // Integer operands of SIToFP and UIToFP stay bitvectors
+  bool intOperands =
+      e->getKind() == Expr::SIToFP || e->getKind() == Expr::UIToFP;
+  for (unsigned int i = 0; i < e->getNumKids(); i++) {
+    printSeperator();
+    if (intOperands)
+      printExpression(e->getKid(i), SORT_BITVECTOR);
+    else
+      printAsFloatingPoint(e->getKid(i));
+  }
+
+  p->popIndent(); // pop indent added for recursive call
+  printSeperator();
+  *p << ")";
+  if (floatResult)
+    *p << ")";
+}
+
 const char *ExprSMTLIBPrinter::getSMTLIBKeyword(const ref<Expr> &e) {
 
   switch (e->getKind()) {
@@ -546,6 +650,8 @@ void ExprSMTLIBPrinter::printSetLogic() {
     *o << "QF_AUFBV";
     break;
   }
+  if (haveFloatingPoint)
+    *o << "FP";
   *o << " )\n";
 }
 
@@ -712,6 +818,10 @@ void ExprSMTLIBPrinter::scan(const ref<Expr> &e) {
       }
     }
 
+    if (isa<FPCastExpr>(e) || isa<FCmpExpr>(e) ||
+        (e->getKind() >= Expr::FAdd && e->getKind() <= Expr::FDiv))
+      haveFloatingPoint = true;
+
     // recurse into the children
     Expr *ep = e.get();
     for (unsigned int i = 0; i < ep->getNumKids(); i++)
@@ -943,6 +1053,9 @@ ExprSMTLIBPrinter::SMTLIB_SORT ExprSMTLIBPrinter::getSort(const ref<Expr> &e) {
   case Expr::Ule:
   case Expr::Ugt:
   case Expr::Uge:
+  case Expr::FOEq:
+  case Expr::FOLt:
+  case Expr::FOLe:
     return SORT_BOOL;
 
   // These may be bitvectors or bools depending on their width (see
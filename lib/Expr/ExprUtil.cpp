@@ -12,6 +12,7 @@
 #include "klee/Expr/ExprHashMap.h"
 #include "klee/Expr/ExprVisitor.h"
 
+#include <algorithm>
 #include <set>
 
 using namespace klee;
@@ -73,6 +74,108 @@ void klee::findReads(ref<Expr> e,
   }
 }
 
+void klee::findReadBytes(
+    ref<Expr> e, std::map<const Array *, std::set<std::uint64_t>> &result) {
+  std::vector<ref<Expr>> stack;
+  ExprHashSet visited;
+  auto push = [&](const ref<Expr> &e) {
+    if (!isa<ConstantExpr>(e) && visited.insert(e).second)
+      stack.push_back(e);
+  };
+  auto addArray = [&](const Array *array) {
+    std::set<std::uint64_t> &bytes = result[array];
+    for (std::uint64_t i = 0; i < array->size; ++i)
+      bytes.insert(i);
+  };
+
+  push(e);
+  while (!stack.empty()) {
+    ref<Expr> top = stack.back();
+    stack.pop_back();
+
+    const ReadExpr *re = dyn_cast<ReadExpr>(top);
+    if (!re) {
+      for (unsigned i = 0; i < top->getNumKids(); i++)
+        push(top->getKid(i));
+      continue;
+    }
+
+    const UpdateList &ul = re->updates;
+    push(re->index);
+    const ConstantExpr *index = dyn_cast<ConstantExpr>(re->index);
+    bool shadowed = false;
+    for (const auto *un = ul.head.get(); un && !shadowed; un = un->next.get()) {
+      const ConstantExpr *updated = dyn_cast<ConstantExpr>(un->index);
+      // The update cannot be read at this index
+      if (index && updated && index->getZExtValue() != updated->getZExtValue())
+        continue;
+      push(un->index);
+      push(un->value);
+      // Everything older is overwritten at this index
+      shadowed = index && updated;
+    }
+    if (shadowed || !ul.root->isSymbolicArray())
+      continue;
+    if (index)
+      result[ul.root].insert(index->getZExtValue());
+    else
+      addArray(ul.root);
+  }
+}
+
+ExprDAGStats::Shape ExprDAGStats::add(const ref<Expr> &e) {
+  if (isa<ConstantExpr>(e))
+    return {0, 0};
+  if (roots.insert(e).second) {
+    // Post-order traversal: a node is measured once all its kids are
+    std::vector<std::pair<ref<Expr>, bool>> stack{{e, false}};
+    while (!stack.empty()) {
+      ref<Expr> top = stack.back().first;
+      bool kidsDone = stack.back().second;
+      stack.pop_back();
+      if (shapes.count(top))
+        continue;
+      unsigned numKids = top->getNumKids();
+      if (!kidsDone) {
+        stack.emplace_back(top, true);
+        for (unsigned i = 0; i < numKids; ++i) {
+          ref<Expr> kid = top->getKid(i);
+          if (!isa<ConstantExpr>(kid) && !shapes.count(kid))
+            stack.emplace_back(kid, false);
+        }
+        continue;
+      }
+
+      Shape shape{1, 1};
+      for (unsigned i = 0; i < numKids; ++i) {
+        ref<Expr> kid = top->getKid(i);
+        if (isa<ConstantExpr>(kid))
+          continue;
+        const Shape &k = shapes.find(kid)->second;
+        shape.depth = std::max(shape.depth, k.depth + 1);
+        shape.treeSize += k.treeSize;
+      }
+      shapes.insert(std::make_pair(top, shape));
+      ++kinds[top->getKind()];
+      if (auto re = dyn_cast<ReadExpr>(top))
+        maxUpdateListLength =
+            std::max<std::uint64_t>(maxUpdateListLength, re->updates.getSize());
+    }
+    const Shape &shape = shapes.find(e)->second;
+    totalDepth += shape.depth;
+    totalTreeSize += shape.treeSize;
+  }
+  return shapes.find(e)->second;
+}
+
+double ExprDAGStats::getAverageDepth() const {
+  return roots.empty() ? 0 : double(totalDepth) / roots.size();
+}
+
+double ExprDAGStats::getSharing() const {
+  return shapes.empty() ? 1 : totalTreeSize / shapes.size();
+}
+
 ///
 
 namespace klee {
@@ -9,6 +9,8 @@
 
 #include "klee/Expr/Expr.h"
 
+#include "klee/Expr/ArrayCache.h"
+
 #include <cassert>
 
 using namespace klee;
@@ -46,7 +48,41 @@ unsigned UpdateNode::computeHash() {
 ///
 
 UpdateList::UpdateList(const Array *_root, const ref<UpdateNode> &_head)
-    : root(_root), head(_head) {}
+    : root(_root), head(_head) {
+  retain(root);
+}
+
+UpdateList::UpdateList(const UpdateList &b) : root(b.root), head(b.head) {
+  retain(root);
+}
+
+UpdateList::~UpdateList() { release(root); }
+
+UpdateList &UpdateList::operator=(const UpdateList &b) {
+  // Retain first, b may be the last reference to our root
+  retain(b.root);
+  release(root);
+  root = b.root;
+  head = b.head;
+  return *this;
+}
+
+void UpdateList::retain(const Array *array) {
+  if (array && array->interned)
+    ++array->refCount;
+}
+
+void UpdateList::release(const Array *array) {
+  if (!array || !array->interned)
+    return;
+  assert(array->refCount > 0 && "unbalanced reference count");
+  if (--array->refCount != 0)
+    return;
+  if (array->cache)
+    array->cache->release(array);
+  else
+    delete array;
+}
 
 void UpdateList::extend(const ref<Expr> &index, const ref<Expr> &value) {
   
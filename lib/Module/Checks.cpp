@@ -13,6 +13,8 @@
 
 #include "KLEEIRMetaData.h"
 
+#include "llvm/Analysis/LazyValueInfo.h"
+#include "llvm/IR/ConstantRange.h"
 #include "llvm/IR/Constants.h"
 #include "llvm/IR/DataLayout.h"
 #include "llvm/IR/DerivedTypes.h"
@@ -25,6 +27,7 @@
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/Type.h"
+#include "llvm/InitializePasses.h"
 #include "llvm/Pass.h"
 #include "llvm/Transforms/Scalar.h"
 #include "llvm/Transforms/Utils/BasicBlockUtils.h"
@@ -32,12 +35,34 @@
 using namespace llvm;
 using namespace klee;
 
+namespace {
+/// Range of the values `value` can take when `inst` executes
+ConstantRange getRangeAt(LazyValueInfo &lvi, Value *value, Instruction *inst) {
+#if LLVM_VERSION_CODE >= LLVM_VERSION(12, 0)
+  return lvi.getConstantRange(value, inst, /*UndefAllowed=*/false);
+#else
+  return lvi.getConstantRange(value, inst->getParent(), inst);
+#endif
+}
+} // namespace
+
 char DivCheckPass::ID;
 
+DivCheckPass::DivCheckPass() : ModulePass(ID) {
+  initializeLazyValueInfoWrapperPassPass(*PassRegistry::getPassRegistry());
+}
+
+void DivCheckPass::getAnalysisUsage(AnalysisUsage &AU) const {
+  AU.addRequired<LazyValueInfoWrapperPass>();
+}
+
 bool DivCheckPass::runOnModule(Module &M) {
   std::vector<llvm::BinaryOperator *> divInstruction;
 
   for (auto &F : M) {
+    if (F.isDeclaration())
+      continue;
+    LazyValueInfo &lvi = getAnalysis<LazyValueInfoWrapperPass>(F).getLVI();
     for (auto &BB : F) {
       for (auto &I : BB) {
         auto binOp = dyn_cast<BinaryOperator>(&I);
@@ -55,6 +80,10 @@ bool DivCheckPass::runOnModule(Module &M) {
         if (const auto &coOp = dyn_cast<llvm::Constant>(operand)) {
           if (!coOp->isZeroValue())
             continue;
+        } else if (!getRangeAt(lvi, operand, binOp).contains(
+                       APInt(operand->getType()->getScalarSizeInBits(), 0))) {
+          // The operand cannot be zero here, e.g. after a test against zero
+          continue;
         }
 
         // Check if the operand is already checked by "klee_div_zero_check"
@@ -90,9 +119,20 @@ bool DivCheckPass::runOnModule(Module &M) {
 
 char OvershiftCheckPass::ID;
 
+OvershiftCheckPass::OvershiftCheckPass() : ModulePass(ID) {
+  initializeLazyValueInfoWrapperPassPass(*PassRegistry::getPassRegistry());
+}
+
+void OvershiftCheckPass::getAnalysisUsage(AnalysisUsage &AU) const {
+  AU.addRequired<LazyValueInfoWrapperPass>();
+}
+
 bool OvershiftCheckPass::runOnModule(Module &M) {
   std::vector<llvm::BinaryOperator *> shiftInstructions;
   for (auto &F : M) {
+    if (F.isDeclaration())
+      continue;
+    LazyValueInfo &lvi = getAnalysis<LazyValueInfoWrapperPass>(F).getLVI();
     for (auto &BB : F) {
       for (auto &I : BB) {
         auto binOp = dyn_cast<BinaryOperator>(&I);
@@ -114,6 +154,11 @@ bool OvershiftCheckPass::runOnModule(Module &M) {
           // we can ignore this instruction
           if (!coOp->isNegative() && coOp->getZExtValue() < typeWidth)
             continue;
+        } else if (getRangeAt(lvi, operand, binOp)
+                       .getUnsignedMax()
+                       .ult(binOp->getType()->getScalarSizeInBits())) {
+          // The shift amount is known to be in range, e.g. masked
+          continue;
         }
 
         if (KleeIRMetaData::hasAnnotation(I, "klee.check.shift", "True"))
@@ -92,12 +92,15 @@ public:
   bool runOnFunction(llvm::Function &f) override;
 };
 
+/// This pass injects checks for divisions by zero, except where the lazy
+/// value info proves the divisor non-zero.
 class DivCheckPass : public llvm::ModulePass {
   static char ID;
 
 public:
-  DivCheckPass() : ModulePass(ID) {}
+  DivCheckPass();
   bool runOnModule(llvm::Module &M) override;
+  void getAnalysisUsage(llvm::AnalysisUsage &AU) const override;
 };
 
 /// This pass injects checks to check for overshifting.
@@ -114,12 +117,16 @@ public:
 ///     x << 8 ; // Undefined behaviour
 ///     x << 255 ; // Undefined behaviour
 /// \endcode
+///
+/// Shifts whose amount the lazy value info proves smaller than the width are
+/// not checked.
 class OvershiftCheckPass : public llvm::ModulePass {
   static char ID;
 
 public:
-  OvershiftCheckPass() : ModulePass(ID) {}
+  OvershiftCheckPass();
   bool runOnModule(llvm::Module &M) override;
+  void getAnalysisUsage(llvm::AnalysisUsage &AU) const override;
 };
 
 /// LowerSwitchPass - Replace all SwitchInst instructions with chained branch
@@ -0,0 +1,116 @@
+//===-- Slicing.cpp -------------------------------------------------------===//
+//
+//                     The KLEE Symbolic Virtual Machine
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "klee/Config/Version.h"
+#include "klee/Support/ModuleUtil.h"
+
+#include "llvm/ADT/StringSet.h"
+#include "llvm/Analysis/ValueTracking.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/IntrinsicInst.h"
+
+using namespace llvm;
+using namespace klee;
+
+namespace {
+/// C library functions that only write to the standard streams. Functions
+/// taking a FILE * are left out, as the stream may be a file the program
+/// reads back.
+const StringSet<> OutputFunctions = {
+    "printf", "vprintf", "puts", "putchar", "perror",
+};
+
+/// Whether `pointer` points into a stack object of f
+bool isLocal(const Function &f, const Value *pointer) {
+#if LLVM_VERSION_CODE >= LLVM_VERSION(12, 0)
+  const Value *object = getUnderlyingObject(pointer);
+#else
+  const Value *object =
+      GetUnderlyingObject(pointer, f.getParent()->getDataLayout());
+#endif
+  auto alloca = dyn_cast<AllocaInst>(object);
+  return alloca && alloca->getFunction() == &f;
+}
+
+/// Whether an intrinsic call has no effect outside of the stack of f
+bool isLocalIntrinsic(const Function &f, const IntrinsicInst &ii) {
+  if (isa<DbgInfoIntrinsic>(ii) || ii.doesNotAccessMemory())
+    return true;
+  if (auto mi = dyn_cast<MemIntrinsic>(&ii))
+    return isLocal(f, mi->getRawDest());
+  switch (ii.getIntrinsicID()) {
+  case Intrinsic::lifetime_start:
+  case Intrinsic::lifetime_end:
+  case Intrinsic::vaend:
+    return true;
+  case Intrinsic::vastart:
+  case Intrinsic::vacopy:
+    return isLocal(f, ii.getArgOperand(0));
+  default:
+    return false;
+  }
+}
+
+/// Whether the body of f only writes its own stack and only calls functions
+/// in `outputOnly`
+bool hasOnlyOutputEffects(
+    const Function &f,
+    const std::set<const llvm::Function *> &outputOnly) {
+  for (const Instruction &i : instructions(f)) {
+    if (auto si = dyn_cast<StoreInst>(&i)) {
+      if (!isLocal(f, si->getPointerOperand()))
+        return false;
+    } else if (auto ii = dyn_cast<IntrinsicInst>(&i)) {
+      if (!isLocalIntrinsic(f, *ii))
+        return false;
+    } else if (auto cb = dyn_cast<CallBase>(&i)) {
+      const Function *callee = getDirectCallTarget(*cb, true);
+      if (!callee || !outputOnly.count(callee))
+        return false;
+    } else if (i.mayWriteToMemory() || isa<ResumeInst>(i) ||
+               isa<UnreachableInst>(i)) {
+      // Atomics, fences, exceptions and known crashes
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+std::set<const llvm::Function *>
+klee::getOutputOnlyFunctions(const llvm::Module &m,
+                             const std::set<const llvm::Function *> &keep) {
+  // Start from every candidate and drop functions until none calls a dropped
+  // one, so that (mutually) recursive output functions are kept
+  std::set<const llvm::Function *> outputOnly;
+  for (const Function &f : m) {
+    if (keep.count(&f))
+      continue;
+    if (OutputFunctions.count(f.getName()) || !f.isDeclaration())
+      outputOnly.insert(&f);
+  }
+
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (auto it = outputOnly.begin(); it != outputOnly.end();) {
+      const Function &f = **it;
+      if (OutputFunctions.count(f.getName()) ||
+          hasOnlyOutputEffects(f, outputOnly)) {
+        ++it;
+        continue;
+      }
+      it = outputOnly.erase(it);
+      changed = true;
+    }
+  }
+  return outputOnly;
+}
@@ -139,6 +139,9 @@ private:
   SolverContext &_solver;
   bool _optimizeDivides;
   MetaSMTArrayExprHash<SolverContext> _arr_hash;
+  /// _arr_hash is keyed by address, so keep its arrays (interned constant
+  /// arrays are freed once unused) alive
+  std::vector<UpdateList> hashedArrays;
   MetaSMTExprHashMap _constructed;
 
   typename SolverContext::result_type constructActual(ref<Expr> e,
@@ -225,6 +228,7 @@ MetaSMTBuilder<SolverContext>::getInitialArray(const Array *root) {
       }
     }
     _arr_hash.hashArrayExpr(root, array_expr);
+    hashedArrays.emplace_back(root, nullptr);
   }
 
   return (array_expr);
@@ -457,6 +457,7 @@ ExprHandle STPBuilder::constructSDivByConstant(ExprHandle expr_n, unsigned width
     }
     
     _arr_hash.hashArrayExpr(root, array_expr);
+    hashedArrays.emplace_back(root, nullptr);
   }
   
   return array_expr;
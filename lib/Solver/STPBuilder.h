@@ -72,6 +72,9 @@ class STPBuilder {
   bool optimizeDivides;
 
   STPArrayExprHash _arr_hash;
+  /// _arr_hash is keyed by address, so keep its arrays (interned constant
+  /// arrays are freed once unused) alive
+  std::vector<UpdateList> hashedArrays;
 
 private:  
 
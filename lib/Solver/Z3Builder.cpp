@@ -19,6 +19,7 @@
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/ADT/iterator_range.h"
 #include "llvm/Support/CommandLine.h"
+#include "llvm/Support/ErrorHandling.h"
 
 using namespace klee;
 
@@ -101,9 +102,7 @@ Z3Builder::Z3Builder(bool autoClearConstructCache, const char* z3LogInteractionF
 Z3Builder::~Z3Builder() {
   // Clear caches so exprs/sorts gets freed before the destroying context
   // they aren associated with.
-  clearConstructCache();
-  _arr_hash.clear();
-  constant_array_assertions.clear();
+  clearArrayCache();
   Z3_del_context(ctx);
   if (z3LogInteractionFile.length() > 0) {
     Z3_close_log();
@@ -116,6 +115,17 @@ Z3SortHandle Z3Builder::getBvSort(unsigned width) {
   return Z3SortHandle(Z3_mk_bv_sort(ctx, width), ctx);
 }
 
+Z3SortHandle Z3Builder::getFloatSortFromWidth(unsigned width) {
+  switch (width) {
+  case Expr::Int32:
+    return Z3SortHandle(Z3_mk_fpa_sort_32(ctx), ctx);
+  case Expr::Int64:
+    return Z3SortHandle(Z3_mk_fpa_sort_64(ctx), ctx);
+  default:
+    llvm::report_fatal_error("Unsupported floating point width");
+  }
+}
+
 Z3SortHandle Z3Builder::getArraySort(Z3SortHandle domainSort,
                                      Z3SortHandle rangeSort) {
   // FIXME: cache these
@@ -384,6 +394,15 @@ Z3ASTHandle Z3Builder::constructAShrByConstant(Z3ASTHandle expr, unsigned shift,
   }
 }
 
+Z3ASTHandle Z3Builder::castToFloat(Z3ASTHandle e, unsigned width) {
+  return Z3ASTHandle(
+      Z3_mk_fpa_to_fp_bv(ctx, e, getFloatSortFromWidth(width)), ctx);
+}
+
+Z3ASTHandle Z3Builder::castFromFloat(Z3ASTHandle e) {
+  return Z3ASTHandle(Z3_mk_fpa_to_ieee_bv(ctx, e), ctx);
+}
+
 Z3ASTHandle Z3Builder::getInitialArray(const Array *root) {
 
   assert(root);
@@ -393,7 +412,7 @@ Z3ASTHandle Z3Builder::getInitialArray(const Array *root) {
   if (!hashed) {
     // Unique arrays by name, so we make sure the name is unique by
     // using the size of the array hash as a counter.
-    std::string unique_id = llvm::utostr(_arr_hash._array_hash.size());
+    std::string unique_id = llvm::utostr(arrayCounter++);
     std::string unique_name = root->name + unique_id;
 
     array_expr = buildArray(unique_name.c_str(), root->getDomain(),
@@ -413,10 +432,13 @@ Z3ASTHandle Z3Builder::getInitialArray(const Array *root) {
             eqExpr(readExpr(array_expr, bvConst32(root->getDomain(), i)),
                    array_value));
       }
+      arrayCacheSize += array_assertions.size();
       constant_array_assertions[root] = std::move(array_assertions);
     }
 
     _arr_hash.hashArrayExpr(root, array_expr);
+    hashedArrays.emplace_back(root, nullptr);
+    ++arrayCacheSize;
   }
 
   return (array_expr);
@@ -450,11 +472,33 @@ Z3ASTHandle Z3Builder::getArrayForUpdate(const Array *root,
         writeExpr(un_expr, construct(un->index, 0), construct(un->value, 0));
 
     _arr_hash.hashUpdateNodeExpr(un, un_expr);
+    hashedUpdateNodes.emplace_back(un);
+    ++arrayCacheSize;
   }
 
   return un_expr;
 }
 
+void Z3Builder::clearArrayCache() {
+  clearConstructCache();
+  _arr_hash.clear();
+  constant_array_assertions.clear();
+  hashedArrays.clear();
+  hashedUpdateNodes.clear();
+  arrayCacheSize = 0;
+}
+
+void Z3Builder::trimConstructCache(std::size_t maxSize) {
+  if (arrayCacheSize > maxSize) {
+    clearArrayCache();
+    return;
+  }
+  while (constructed.size() + arrayCacheSize > maxSize) {
+    constructed.erase(constructedLRU.back());
+    constructedLRU.pop_back();
+  }
+}
+
 /** if *width_out!=1 then result is a bitvector,
     otherwise it is a bool */
 Z3ASTHandle Z3Builder::construct(ref<Expr> e, int *width_out) {
@@ -463,18 +507,22 @@ Z3ASTHandle Z3Builder::construct(ref<Expr> e, int *width_out) {
   if (!UseConstructHashZ3 || isa<ConstantExpr>(e)) {
     return constructActual(e, width_out);
   } else {
-    ExprHashMap<std::pair<Z3ASTHandle, unsigned> >::iterator it =
-        constructed.find(e);
+    ExprHashMap<ConstructedEntry>::iterator it = constructed.find(e);
     if (it != constructed.end()) {
+      constructedLRU.splice(constructedLRU.begin(), constructedLRU,
+                            it->second.use);
       if (width_out)
-        *width_out = it->second.second;
-      return it->second.first;
+        *width_out = it->second.width;
+      return it->second.ast;
     } else {
       int width;
       if (!width_out)
         width_out = &width;
       Z3ASTHandle res = constructActual(e, width_out);
-      constructed.insert(std::make_pair(e, std::make_pair(res, *width_out)));
+      constructedLRU.push_front(e);
+      constructed.insert(std::make_pair(
+          e, ConstructedEntry{res, (unsigned)*width_out,
+                              constructedLRU.begin()}));
       return res;
     }
   }
@@ -850,6 +898,103 @@ Z3ASTHandle Z3Builder::constructActual(ref<Expr> e, int *width_out) {
     return sbvLeExpr(left, right);
   }
 
+  // Floating point
+
+  case Expr::FAdd:
+  case Expr::FSub:
+  case Expr::FMul:
+  case Expr::FDiv: {
+    BinaryExpr *be = cast<BinaryExpr>(e);
+    Z3ASTHandle left = castToFloat(construct(be->left, width_out),
+                                   be->left->getWidth());
+    Z3ASTHandle right = castToFloat(construct(be->right, width_out),
+                                    be->right->getWidth());
+    Z3ASTHandle rm(Z3_mk_fpa_round_nearest_ties_to_even(ctx), ctx);
+    Z3_ast result;
+    switch (e->getKind()) {
+    case Expr::FAdd:
+      result = Z3_mk_fpa_add(ctx, rm, left, right);
+      break;
+    case Expr::FSub:
+      result = Z3_mk_fpa_sub(ctx, rm, left, right);
+      break;
+    case Expr::FMul:
+      result = Z3_mk_fpa_mul(ctx, rm, left, right);
+      break;
+    default:
+      result = Z3_mk_fpa_div(ctx, rm, left, right);
+      break;
+    }
+    *width_out = e->getWidth();
+    return castFromFloat(Z3ASTHandle(result, ctx));
+  }
+
+  case Expr::FOEq:
+  case Expr::FOLt:
+  case Expr::FOLe: {
+    FCmpExpr *fe = cast<FCmpExpr>(e);
+    Z3ASTHandle left = castToFloat(construct(fe->left, width_out),
+                                   fe->left->getWidth());
+    Z3ASTHandle right = castToFloat(construct(fe->right, width_out),
+                                    fe->right->getWidth());
+    *width_out = 1;
+    if (e->getKind() == Expr::FOEq)
+      return Z3ASTHandle(Z3_mk_fpa_eq(ctx, left, right), ctx);
+    if (e->getKind() == Expr::FOLt)
+      return Z3ASTHandle(Z3_mk_fpa_lt(ctx, left, right), ctx);
+    return Z3ASTHandle(Z3_mk_fpa_leq(ctx, left, right), ctx);
+  }
+
+  case Expr::FPConvert: {
+    FPCastExpr *ce = cast<FPCastExpr>(e);
+    Z3ASTHandle src = castToFloat(construct(ce->src, width_out),
+                                  ce->src->getWidth());
+    Z3ASTHandle rm(Z3_mk_fpa_round_nearest_ties_to_even(ctx), ctx);
+    *width_out = ce->getWidth();
+    return castFromFloat(Z3ASTHandle(
+        Z3_mk_fpa_to_fp_float(ctx, rm, src,
+                              getFloatSortFromWidth(*width_out)),
+        ctx));
+  }
+
+  case Expr::FPToSI:
+  case Expr::FPToUI: {
+    FPCastExpr *ce = cast<FPCastExpr>(e);
+    Z3ASTHandle src = castToFloat(construct(ce->src, width_out),
+                                  ce->src->getWidth());
+    // C semantics: conversion to integer truncates towards zero
+    Z3ASTHandle rm(Z3_mk_fpa_round_toward_zero(ctx), ctx);
+    *width_out = ce->getWidth();
+    // Z3 has no conversion to a single bit, and values of width 1 are Z3
+    // booleans: convert to a byte and test its lowest bit
+    unsigned width = *width_out == 1 ? 8 : *width_out;
+    Z3ASTHandle result(e->getKind() == Expr::FPToSI
+                           ? Z3_mk_fpa_to_sbv(ctx, rm, src, width)
+                           : Z3_mk_fpa_to_ubv(ctx, rm, src, width),
+                       ctx);
+    if (*width_out == 1)
+      return eqExpr(bvExtract(result, 0, 0), bvOne(1));
+    return result;
+  }
+
+  case Expr::SIToFP:
+  case Expr::UIToFP: {
+    FPCastExpr *ce = cast<FPCastExpr>(e);
+    Z3ASTHandle src = construct(ce->src, width_out);
+    if (*width_out == 1)
+      src = iteExpr(src,
+                    e->getKind() == Expr::SIToFP ? bvMinusOne(8) : bvOne(8),
+                    bvZero(8));
+    Z3ASTHandle rm(Z3_mk_fpa_round_nearest_ties_to_even(ctx), ctx);
+    *width_out = ce->getWidth();
+    Z3SortHandle sort = getFloatSortFromWidth(*width_out);
+    if (e->getKind() == Expr::SIToFP)
+      return castFromFloat(
+          Z3ASTHandle(Z3_mk_fpa_to_fp_signed(ctx, rm, src, sort), ctx));
+    return castFromFloat(
+        Z3ASTHandle(Z3_mk_fpa_to_fp_unsigned(ctx, rm, src, sort), ctx));
+  }
+
 // unused due to canonicalization
 #if 0
   case Expr::Ne:
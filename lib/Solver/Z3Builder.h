@@ -14,7 +14,9 @@
 #include "klee/Expr/ArrayExprHash.h"
 #include "klee/Expr/ExprHashMap.h"
 
+#include <list>
 #include <unordered_map>
+#include <vector>
 #include <z3.h>
 
 namespace klee {
@@ -102,8 +104,25 @@ public:
 };
 
 class Z3Builder {
-  ExprHashMap<std::pair<Z3ASTHandle, unsigned> > constructed;
+  struct ConstructedEntry {
+    Z3ASTHandle ast;
+    unsigned width;
+    /// Position in constructedLRU
+    std::list<ref<Expr> >::iterator use;
+  };
+  ExprHashMap<ConstructedEntry> constructed;
+  /// Keys of constructed, most recently used first
+  std::list<ref<Expr> > constructedLRU;
+
   Z3ArrayExprHash _arr_hash;
+  /// _arr_hash is keyed by address, so keep its arrays (interned constant
+  /// arrays are freed once unused) and update nodes alive
+  std::vector<UpdateList> hashedArrays;
+  std::vector<ref<const UpdateNode> > hashedUpdateNodes;
+  /// Number of ASTs held by _arr_hash and constant_array_assertions
+  std::size_t arrayCacheSize = 0;
+  /// Makes the names of Z3 arrays unique
+  unsigned arrayCounter = 0;
 
 private:
   Z3ASTHandle bvOne(unsigned width);
@@ -155,6 +174,10 @@ private:
   Z3ASTHandle constructAShrByConstant(Z3ASTHandle expr, unsigned shift,
                                       Z3ASTHandle isSigned);
 
+  // Floating point values are kept as IEEE-754 bitvectors in KLEE
+  Z3ASTHandle castToFloat(Z3ASTHandle e, unsigned width);
+  Z3ASTHandle castFromFloat(Z3ASTHandle e);
+
   Z3ASTHandle getInitialArray(const Array *os);
   Z3ASTHandle getArrayForUpdate(const Array *root, const UpdateNode *un);
 
@@ -165,6 +188,7 @@ private:
                          unsigned valueWidth);
 
   Z3SortHandle getBvSort(unsigned width);
+  Z3SortHandle getFloatSortFromWidth(unsigned width);
   Z3SortHandle getArraySort(Z3SortHandle domainSort, Z3SortHandle rangeSort);
   bool autoClearConstructCache;
   std::string z3LogInteractionFile;
@@ -187,7 +211,20 @@ public:
     return res;
   }
 
-  void clearConstructCache() { constructed.clear(); }
+  void clearConstructCache() {
+    constructed.clear();
+    constructedLRU.clear();
+  }
+
+  /// Drop the translations of arrays and update nodes, along with the
+  /// expressions that may refer to them
+  void clearArrayCache();
+
+  /// Evict the least recently used translations until at most \p maxSize
+  /// ASTs are cached, each element of a constant array counting as one. If
+  /// the arrays alone take more, everything is dropped. Must not be called
+  /// while a query is being built.
+  void trimConstructCache(std::size_t maxSize);
 };
 }
 
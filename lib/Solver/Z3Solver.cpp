@@ -45,6 +45,13 @@ llvm::cl::opt<bool> Z3ValidateModels(
     llvm::cl::desc("When generating Z3 models validate these against the query"),
     llvm::cl::cat(klee::SolvingCat));
 
+llvm::cl::opt<unsigned> Z3ConstructCacheSize(
+    "z3-construct-cache-size", llvm::cl::init(100000),
+    llvm::cl::desc("Maximum number of Z3 expressions kept across queries, "
+                   "elements of constant arrays included; 0 translates "
+                   "every query from scratch (default=100000)"),
+    llvm::cl::cat(klee::SolvingCat));
+
 llvm::cl::opt<unsigned>
     Z3VerbosityLevel("debug-z3-verbosity", llvm::cl::init(0),
                      llvm::cl::desc("Z3 verbosity level (default=0)"),
@@ -308,12 +315,13 @@ bool Z3SolverImpl::internalRunSolver(
                                        hasSolution);
 
   Z3_solver_dec_ref(builder->ctx, theSolver);
-  // Clear the builder's cache to prevent memory usage exploding.
-  // By using ``autoClearConstructCache=false`` and clearning now
-  // we allow Z3_ast expressions to be shared from an entire
-  // ``Query`` rather than only sharing within a single call to
+  // Bound the builder's cache to prevent memory usage exploding.
+  // By using ``autoClearConstructCache=false`` and trimming now
+  // we allow Z3_ast expressions to be shared across queries, in
+  // particular constraints common to many queries and constant arrays,
+  // rather than only sharing within a single call to
   // ``builder->construct()``.
-  builder->clearConstructCache();
+  builder->trimConstructCache(Z3ConstructCacheSize);
 
   if (runStatusCode == SolverImpl::SOLVER_RUN_STATUS_SUCCESS_SOLVABLE ||
       runStatusCode == SolverImpl::SOLVER_RUN_STATUS_SUCCESS_UNSOLVABLE) {
@@ -0,0 +1,128 @@
+//===-- CoverageMap.cpp ---------------------------------------------------===//
+//
+//                     The KLEE Symbolic Virtual Machine
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "klee/Support/CoverageMap.h"
+
+#include "llvm/Support/MathExtras.h"
+
+#include <cassert>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+
+using namespace klee;
+
+namespace {
+const char Magic[4] = {'K', 'C', 'O', 'V'};
+const std::uint32_t Version = 1;
+
+/// Finalizer of MurmurHash3, spreads the edges over the whole map
+std::uint32_t mix(std::uint32_t h) {
+  h ^= h >> 16;
+  h *= 0x85ebca6b;
+  h ^= h >> 13;
+  h *= 0xc2b2ae35;
+  h ^= h >> 16;
+  return h;
+}
+
+void putUInt32(std::uint8_t *out, std::uint32_t value) {
+  for (unsigned i = 0; i < 4; ++i)
+    out[i] = value >> (8 * i);
+}
+
+std::uint32_t getUInt32(const std::uint8_t *in) {
+  std::uint32_t value = 0;
+  for (unsigned i = 0; i < 4; ++i)
+    value |= std::uint32_t(in[i]) << (8 * i);
+  return value;
+}
+
+struct FileCloser {
+  void operator()(FILE *f) const { fclose(f); }
+};
+} // namespace
+
+CoverageMap::CoverageMap(std::size_t size) : bits(size) {
+  assert(size && (size & (size - 1)) == 0 &&
+         "coverage map size must be a power of two");
+}
+
+std::uint32_t CoverageMap::hashEdge(std::uint32_t from, std::uint32_t to,
+                                    std::uint32_t context) {
+  return mix(mix(from) ^ (to * 0x9e3779b1) ^ context);
+}
+
+std::size_t CoverageMap::count() const {
+  std::size_t res = 0;
+  for (std::uint8_t byte : bits)
+    res += llvm::countPopulation(byte);
+  return res;
+}
+
+std::size_t CoverageMap::merge(const CoverageMap &other) {
+  assert(bits.size() == other.bits.size() && "merging maps of different size");
+  std::size_t added = 0;
+  for (std::size_t i = 0, e = bits.size(); i != e; ++i) {
+    std::uint8_t fresh = other.bits[i] & ~bits[i];
+    if (fresh) {
+      added += llvm::countPopulation(fresh);
+      bits[i] |= fresh;
+    }
+  }
+  return added;
+}
+
+bool CoverageMap::write(const std::string &path, std::string &error) const {
+  std::unique_ptr<FILE, FileCloser> f(fopen(path.c_str(), "wb"));
+  if (!f) {
+    error = strerror(errno);
+    return false;
+  }
+  std::uint8_t header[12];
+  memcpy(header, Magic, sizeof(Magic));
+  putUInt32(header + 4, Version);
+  putUInt32(header + 8, bits.size());
+  if (fwrite(header, 1, sizeof(header), f.get()) != sizeof(header) ||
+      fwrite(bits.data(), 1, bits.size(), f.get()) != bits.size()) {
+    error = strerror(errno);
+    return false;
+  }
+  return true;
+}
+
+bool CoverageMap::read(const std::string &path, std::string &error) {
+  std::unique_ptr<FILE, FileCloser> f(fopen(path.c_str(), "rb"));
+  if (!f) {
+    error = strerror(errno);
+    return false;
+  }
+  std::uint8_t header[12];
+  if (fread(header, 1, sizeof(header), f.get()) != sizeof(header) ||
+      memcmp(header, Magic, sizeof(Magic)) != 0) {
+    error = "not a coverage map";
+    return false;
+  }
+  if (getUInt32(header + 4) != Version) {
+    error = "unsupported coverage map version";
+    return false;
+  }
+  std::uint32_t size = getUInt32(header + 8);
+  if (!size || (size & (size - 1))) {
+    error = "invalid coverage map size";
+    return false;
+  }
+  bits.assign(size, 0);
+  if (fread(bits.data(), 1, size, f.get()) != size) {
+    error = "truncated coverage map";
+    return false;
+  }
+  return true;
+}
@@ -0,0 +1,231 @@
+//===-- DependencyIndex.cpp -----------------------------------------------===//
+//
+//                     The KLEE Symbolic Virtual Machine
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "klee/Support/DependencyIndex.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+
+using namespace klee;
+
+namespace {
+const char Magic[4] = {'K', 'D', 'E', 'P'};
+const std::uint32_t Version = 2;
+
+struct FileCloser {
+  void operator()(FILE *f) const { fclose(f); }
+};
+
+class Writer {
+  std::vector<std::uint8_t> &out;
+
+public:
+  explicit Writer(std::vector<std::uint8_t> &out) : out(out) {}
+
+  void putUInt32(std::uint32_t value) {
+    for (unsigned i = 0; i < 4; ++i)
+      out.push_back(value >> (8 * i));
+  }
+
+  void putString(const std::string &s) {
+    putUInt32(s.size());
+    out.insert(out.end(), s.begin(), s.end());
+  }
+};
+} // namespace
+
+namespace klee {
+/// Cursor over the contents of a dependency index file
+class DependencyIndexReader {
+  const std::vector<std::uint8_t> &in;
+  std::size_t position = 0;
+
+public:
+  explicit DependencyIndexReader(const std::vector<std::uint8_t> &in)
+      : in(in) {}
+
+  bool getUInt32(std::uint32_t &value) {
+    if (in.size() - position < 4)
+      return false;
+    value = 0;
+    for (unsigned i = 0; i < 4; ++i)
+      value |= std::uint32_t(in[position++]) << (8 * i);
+    return true;
+  }
+
+  bool getString(std::string &s) {
+    std::uint32_t size;
+    if (!getUInt32(size) || in.size() - position < size)
+      return false;
+    s.assign(in.begin() + position, in.begin() + position + size);
+    position += size;
+    return true;
+  }
+};
+} // namespace klee
+
+std::vector<DependencyIndex::Range> DependencyIndex::Site::getRanges() const {
+  std::vector<Range> ranges;
+  for (const auto &object : bytes) {
+    for (std::uint32_t offset : object.second) {
+      if (!ranges.empty() && ranges.back().object == object.first &&
+          ranges.back().end == offset)
+        ++ranges.back().end;
+      else
+        ranges.push_back(Range{object.first, offset, offset + 1});
+    }
+  }
+  return ranges;
+}
+
+std::uint32_t DependencyIndex::getObject(const std::string &name,
+                                         std::uint32_t size) {
+  auto it = objectIndices.emplace(name, objects.size());
+  if (it.second) {
+    objects.push_back(name);
+    objectSizes.push_back(size);
+  }
+  std::uint32_t index = it.first->second;
+  if (objectSizes[index] < size)
+    objectSizes[index] = size;
+  return index;
+}
+
+DependencyIndex::Site &DependencyIndex::getSite(std::uint32_t assemblyLine,
+                                                const std::string &file,
+                                                std::uint32_t line) {
+  Site &site = sites[assemblyLine];
+  if (site.file.empty() && !site.line) {
+    site.file = file;
+    site.line = line;
+  }
+  return site;
+}
+
+bool DependencyIndex::write(const std::string &path,
+                            std::string &error) const {
+  std::vector<std::uint8_t> buffer(Magic, Magic + sizeof(Magic));
+  Writer out(buffer);
+  out.putUInt32(Version);
+  out.putUInt32(objects.size());
+  for (std::size_t i = 0; i < objects.size(); ++i) {
+    out.putString(objects[i]);
+    out.putUInt32(objectSizes[i]);
+  }
+  out.putUInt32(sites.size());
+  for (const auto &entry : sites) {
+    const Site &site = entry.second;
+    out.putUInt32(entry.first);
+    out.putUInt32(site.line);
+    out.putString(site.file);
+    std::vector<Range> ranges = site.getRanges();
+    out.putUInt32(ranges.size());
+    for (const Range &range : ranges) {
+      out.putUInt32(range.object);
+      out.putUInt32(range.begin);
+      out.putUInt32(range.end);
+    }
+  }
+
+  std::unique_ptr<FILE, FileCloser> f(fopen(path.c_str(), "wb"));
+  if (!f ||
+      fwrite(buffer.data(), 1, buffer.size(), f.get()) != buffer.size()) {
+    error = strerror(errno);
+    return false;
+  }
+  return true;
+}
+
+bool DependencyIndex::read(const std::string &path, std::string &error) {
+  std::unique_ptr<FILE, FileCloser> f(fopen(path.c_str(), "rb"));
+  if (!f) {
+    error = strerror(errno);
+    return false;
+  }
+  std::vector<std::uint8_t> buffer;
+  std::uint8_t chunk[4096];
+  std::size_t n;
+  while ((n = fread(chunk, 1, sizeof(chunk), f.get())) > 0)
+    buffer.insert(buffer.end(), chunk, chunk + n);
+  if (buffer.size() < sizeof(Magic) ||
+      memcmp(buffer.data(), Magic, sizeof(Magic)) != 0) {
+    error = "not a dependency index";
+    return false;
+  }
+
+  DependencyIndexReader in(buffer);
+  std::uint32_t magic, version;
+  in.getUInt32(magic);
+  if (!in.getUInt32(version) || version != Version) {
+    error = "unsupported dependency index version";
+    return false;
+  }
+
+  objects.clear();
+  objectSizes.clear();
+  objectIndices.clear();
+  sites.clear();
+  if (!readContents(in, error)) {
+    if (error.empty())
+      error = "truncated dependency index";
+    return false;
+  }
+  return true;
+}
+
+bool DependencyIndex::readContents(DependencyIndexReader &in,
+                                   std::string &error) {
+  std::uint32_t numObjects, numSites;
+  if (!in.getUInt32(numObjects))
+    return false;
+  for (std::uint32_t i = 0; i < numObjects; ++i) {
+    std::string name;
+    std::uint32_t size;
+    if (!in.getString(name) || !in.getUInt32(size))
+      return false;
+    if (getObject(name, size) != i) {
+      error = "duplicate dependency index object";
+      return false;
+    }
+  }
+  if (!in.getUInt32(numSites))
+    return false;
+  for (std::uint32_t i = 0; i < numSites; ++i) {
+    std::uint32_t assemblyLine, line, numRanges;
+    std::string file;
+    if (!in.getUInt32(assemblyLine) || !in.getUInt32(line) ||
+        !in.getString(file) || !in.getUInt32(numRanges))
+      return false;
+    Site &site = getSite(assemblyLine, file, line);
+    // Ranges are written ordered and disjoint, so that a site holds at most
+    // the bytes of its objects however the file was made
+    Range previous{0, 0, 0};
+    for (std::uint32_t j = 0; j < numRanges; ++j) {
+      Range range;
+      if (!in.getUInt32(range.object) || !in.getUInt32(range.begin) ||
+          !in.getUInt32(range.end))
+        return false;
+      bool ordered = j == 0 || previous.object < range.object ||
+                     (previous.object == range.object &&
+                      previous.end <= range.begin);
+      if (range.object >= objects.size() || range.begin >= range.end ||
+          range.end > objectSizes[range.object] || !ordered) {
+        error = "invalid dependency index range";
+        return false;
+      }
+      previous = range;
+      std::set<std::uint32_t> &bytes = site.bytes[range.object];
+      for (std::uint32_t offset = range.begin; offset < range.end; ++offset)
+        bytes.insert(offset);
+    }
+  }
+  return true;
+}
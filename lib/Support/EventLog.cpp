@@ -0,0 +1,363 @@
+//===-- EventLog.cpp ------------------------------------------------------===//
+//
+//                     The KLEE Symbolic Virtual Machine
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "klee/Support/EventLog.h"
+#include "klee/Support/ErrorHandling.h"
+
+#include <atomic>
+#include <cassert>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+using namespace klee;
+
+namespace {
+
+/// Single producer, single consumer ring buffer of events
+class EventRing {
+  static constexpr std::size_t Capacity = 1 << 14;
+  static constexpr std::size_t Mask = Capacity - 1;
+
+  std::vector<Event> slots;
+  /// Next slot to be read, only written by the consumer
+  std::atomic<std::size_t> head{0};
+  /// Next slot to be written, only written by the producer
+  std::atomic<std::size_t> tail{0};
+
+public:
+  EventRing() : slots(Capacity) {}
+
+  /// Moves the event into the ring unless it is full, returns the number
+  /// of events queued before (or Capacity if full)
+  std::size_t tryPush(Event &event) {
+    std::size_t t = tail.load(std::memory_order_relaxed);
+    std::size_t size = t - head.load(std::memory_order_acquire);
+    if (size == Capacity)
+      return Capacity;
+    slots[t & Mask] = std::move(event);
+    tail.store(t + 1, std::memory_order_release);
+    return size;
+  }
+
+  void drain(std::vector<Event> &out) {
+    std::size_t h = head.load(std::memory_order_relaxed);
+    std::size_t t = tail.load(std::memory_order_acquire);
+    for (; h != t; ++h)
+      out.push_back(std::move(slots[h & Mask]));
+    head.store(h, std::memory_order_release);
+  }
+
+  static constexpr std::size_t getCapacity() { return Capacity; }
+};
+
+class EventLogger {
+  std::vector<std::unique_ptr<EventSink>> sinks;
+
+  /// Rings of all threads that logged since start()
+  std::vector<std::unique_ptr<EventRing>> rings;
+  std::timed_mutex ringsMutex;
+
+  std::atomic<bool> running{false};
+  std::atomic<bool> stopRequested{false};
+  /// Incremented on every stop() to invalidate the cached thread rings
+  std::atomic<unsigned> generation{0};
+
+  std::thread writer;
+  /// Held while events are drained and written, so that flush() can do it
+  /// from another thread
+  std::timed_mutex writeMutex;
+  std::mutex wakeMutex;
+  std::condition_variable wake;
+
+  void drain(std::vector<Event> &batch) {
+    std::lock_guard<std::timed_mutex> lock(ringsMutex);
+    for (auto &ring : rings)
+      ring->drain(batch);
+  }
+
+  void run() {
+    std::vector<Event> batch;
+    while (true) {
+      // Read the flag before draining so that nothing logged before stop()
+      // is lost
+      bool stopping = stopRequested.load(std::memory_order_acquire);
+      std::unique_lock<std::timed_mutex> writeLock(writeMutex);
+      drain(batch);
+      if (!batch.empty()) {
+        for (auto &sink : sinks)
+          sink->write(batch);
+        batch.clear();
+        continue;
+      }
+      writeLock.unlock();
+      if (stopping)
+        break;
+      std::unique_lock<std::mutex> lock(wakeMutex);
+      wake.wait_for(lock, std::chrono::milliseconds(10));
+    }
+    for (auto &sink : sinks)
+      sink->flush();
+  }
+
+  EventRing *getThreadRing() {
+    thread_local EventRing *ring = nullptr;
+    thread_local unsigned ringGeneration = 0;
+    unsigned current = generation.load(std::memory_order_acquire);
+    if (!ring || ringGeneration != current) {
+      std::lock_guard<std::timed_mutex> lock(ringsMutex);
+      rings.push_back(std::make_unique<EventRing>());
+      ring = rings.back().get();
+      ringGeneration = current;
+    }
+    return ring;
+  }
+
+public:
+  ~EventLogger() { stop(); }
+
+  void addSink(std::unique_ptr<EventSink> sink) {
+    assert(!running && "sinks have to be added before starting the log");
+    sinks.push_back(std::move(sink));
+  }
+
+  void start() {
+    if (running)
+      return;
+    stopRequested = false;
+    running = true;
+    writer = std::thread([this] { run(); });
+  }
+
+  void stop() {
+    if (!running)
+      return;
+    running = false;
+    stopRequested = true;
+    wake.notify_one();
+    writer.join();
+    sinks.clear();
+    std::lock_guard<std::timed_mutex> lock(ringsMutex);
+    rings.clear();
+    ++generation;
+  }
+
+  void flush() {
+    // A signal handler may interrupt the writer itself, or a thread that
+    // holds a lock forever: never wait on either
+    if (!running.load(std::memory_order_acquire) ||
+        std::this_thread::get_id() == writer.get_id())
+      return;
+    std::unique_lock<std::timed_mutex> writeLock(writeMutex,
+                                                 std::chrono::seconds(1));
+    if (!writeLock.owns_lock())
+      return;
+    std::unique_lock<std::timed_mutex> ringsLock(ringsMutex,
+                                                 std::chrono::seconds(1));
+    if (!ringsLock.owns_lock())
+      return;
+    std::vector<Event> batch;
+    for (auto &ring : rings)
+      ring->drain(batch);
+    ringsLock.unlock();
+    for (auto &sink : sinks) {
+      sink->write(batch);
+      sink->flush();
+    }
+  }
+
+  void log(EventKind kind, std::uint32_t stateID, std::string text) {
+    if (!running.load(std::memory_order_acquire))
+      return;
+    EventRing *ring = getThreadRing();
+    Event event{kind, stateID, std::move(text)};
+    std::size_t queued;
+    while ((queued = ring->tryPush(event)) == EventRing::getCapacity()) {
+      // Full: let the writer catch up rather than dropping events
+      wake.notify_one();
+      std::this_thread::yield();
+    }
+    if (queued == EventRing::getCapacity() / 2)
+      wake.notify_one();
+  }
+};
+
+EventLogger &getLogger() {
+  static EventLogger logger;
+  return logger;
+}
+
+const char *getTextPrefix(EventKind kind) {
+  switch (kind) {
+  case EventKind::PPC:
+    return "PartialPathCondition";
+  case EventKind::Expr:
+    return "VariableExpression";
+  case EventKind::Trace:
+    return "TRACE";
+  case EventKind::Concrete:
+    return "CONCRETE";
+  case EventKind::Taint:
+    return "TaintTrack";
+  case EventKind::Memory:
+    return "MemoryTrack";
+  }
+  return "";
+}
+
+FILE *openLogFile(const std::string &path) {
+  FILE *f = fopen(path.c_str(), "w");
+  if (!f)
+    klee_error("cannot open file \"%s\": %s", path.c_str(), strerror(errno));
+  return f;
+}
+
+class TextEventSink : public EventSink {
+  FILE *files[NumEventKinds];
+  std::string buffers[NumEventKinds];
+
+public:
+  explicit TextEventSink(const std::string &directory) {
+    for (unsigned k = 0; k < NumEventKinds; ++k)
+      files[k] = openLogFile(directory + "/" +
+                             getEventKindName(static_cast<EventKind>(k)) +
+                             ".log");
+  }
+
+  ~TextEventSink() override {
+    flush();
+    for (auto *f : files)
+      fclose(f);
+  }
+
+  void write(const std::vector<Event> &events) override {
+    for (const auto &event : events) {
+      std::string &buffer = buffers[static_cast<unsigned>(event.kind)];
+      buffer += "KLEE: ";
+      buffer += getTextPrefix(event.kind);
+      buffer += ": ";
+      buffer += event.text;
+      buffer += '\n';
+    }
+    for (unsigned k = 0; k < NumEventKinds; ++k) {
+      fwrite(buffers[k].data(), 1, buffers[k].size(), files[k]);
+      buffers[k].clear();
+    }
+  }
+
+  void flush() override {
+    for (auto *f : files)
+      fflush(f);
+  }
+};
+
+class JSONEventSink : public EventSink {
+  FILE *file;
+  std::string buffer;
+
+  void appendEscaped(const std::string &s) {
+    for (char c : s) {
+      switch (c) {
+      case '"':
+        buffer += "\\\"";
+        break;
+      case '\\':
+        buffer += "\\\\";
+        break;
+      case '\n':
+        buffer += "\\n";
+        break;
+      case '\t':
+        buffer += "\\t";
+        break;
+      case '\r':
+        buffer += "\\r";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          char escaped[8];
+          snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+          buffer += escaped;
+        } else {
+          buffer += c;
+        }
+      }
+    }
+  }
+
+public:
+  explicit JSONEventSink(const std::string &path) : file(openLogFile(path)) {}
+
+  ~JSONEventSink() override {
+    flush();
+    fclose(file);
+  }
+
+  void write(const std::vector<Event> &events) override {
+    for (const auto &event : events) {
+      buffer += "{\"kind\":\"";
+      buffer += getEventKindName(event.kind);
+      buffer += "\",\"state\":";
+      buffer += std::to_string(event.stateID);
+      buffer += ",\"text\":\"";
+      appendEscaped(event.text);
+      buffer += "\"}\n";
+    }
+    fwrite(buffer.data(), 1, buffer.size(), file);
+    buffer.clear();
+  }
+
+  void flush() override { fflush(file); }
+};
+} // namespace
+
+const char *klee::getEventKindName(EventKind kind) {
+  switch (kind) {
+  case EventKind::PPC:
+    return "ppc";
+  case EventKind::Expr:
+    return "expr";
+  case EventKind::Trace:
+    return "trace";
+  case EventKind::Concrete:
+    return "concrete";
+  case EventKind::Taint:
+    return "taint";
+  case EventKind::Memory:
+    return "memory";
+  }
+  return "";
+}
+
+std::unique_ptr<EventSink>
+klee::createTextEventSink(const std::string &directory) {
+  return std::make_unique<TextEventSink>(directory);
+}
+
+std::unique_ptr<EventSink> klee::createJSONEventSink(const std::string &path) {
+  return std::make_unique<JSONEventSink>(path);
+}
+
+void EventLog::addSink(std::unique_ptr<EventSink> sink) {
+  getLogger().addSink(std::move(sink));
+}
+
+void EventLog::start() { getLogger().start(); }
+
+void EventLog::stop() { getLogger().stop(); }
+
+void EventLog::flush() { getLogger().flush(); }
+
+void EventLog::log(EventKind kind, std::uint32_t stateID, std::string text) {
+  getLogger().log(kind, stateID, std::move(text));
+}
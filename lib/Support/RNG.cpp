@@ -65,6 +65,7 @@ RNG::RNG(unsigned int s) {
 }
 
 void RNG::seed(unsigned int s) {
+  initialSeed = s;
   mt[0]= s & 0xffffffffUL;
   for (mti=1; mti<N; mti++) {
     mt[mti] = 
@@ -0,0 +1,220 @@
+//===-- ReplayLog.cpp -----------------------------------------------------===//
+//
+//                     The KLEE Symbolic Virtual Machine
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "klee/Support/ReplayLog.h"
+
+#include "klee/Support/ErrorHandling.h"
+
+#include <cassert>
+#include <cerrno>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+
+using namespace klee;
+
+namespace {
+const char Magic[4] = {'K', 'R', 'P', 'L'};
+const std::uint8_t Version = 1;
+
+/// Set in the kind byte of events that carry bytes
+const std::uint8_t HasData = 0x80;
+
+/// Recorded events are written in chunks of at least this size
+const std::size_t FlushSize = 1 << 16;
+
+struct FileCloser {
+  void operator()(FILE *f) const { fclose(f); }
+};
+
+enum class Mode { Off, Record, Replay };
+
+Mode mode = Mode::Off;
+std::string logPath;
+std::unique_ptr<FILE, FileCloser> output;
+/// Pending recorded events, or the whole log when replaying
+std::vector<std::uint8_t> buffer;
+std::size_t position = 0;
+/// Number of events replayed so far, for error messages
+std::uint64_t numReplayed = 0;
+
+void putVarint(std::uint64_t value) {
+  while (value >= 0x80) {
+    buffer.push_back(std::uint8_t(value) | 0x80);
+    value >>= 7;
+  }
+  buffer.push_back(std::uint8_t(value));
+}
+
+bool getVarint(std::size_t &at, std::uint64_t &value) {
+  value = 0;
+  for (unsigned shift = 0; at < buffer.size() && shift < 64; shift += 7) {
+    std::uint8_t byte = buffer[at++];
+    value |= std::uint64_t(byte & 0x7f) << shift;
+    if (!(byte & 0x80))
+      return true;
+  }
+  return false;
+}
+
+void flush() {
+  if (buffer.empty())
+    return;
+  if (fwrite(buffer.data(), 1, buffer.size(), output.get()) != buffer.size())
+    klee_error("unable to write replay log %s: %s", logPath.c_str(),
+               strerror(errno));
+  buffer.clear();
+}
+
+/// Decode the event at `at` and advance past it. Returns false at the end
+/// of the log.
+bool decode(std::size_t &at, ReplayEventKind &kind, std::uint64_t &value,
+            std::vector<std::uint8_t> *data) {
+  if (at >= buffer.size())
+    return false;
+  std::uint8_t tag = buffer[at++];
+  std::uint64_t size = 0;
+  if (!getVarint(at, value) || ((tag & HasData) && !getVarint(at, size)) ||
+      buffer.size() - at < size)
+    klee_error("truncated replay log %s", logPath.c_str());
+  kind = ReplayEventKind(tag & ~HasData);
+  if (data)
+    data->assign(buffer.begin() + at, buffer.begin() + at + size);
+  at += size;
+  return true;
+}
+} // namespace
+
+const char *klee::getReplayEventKindName(ReplayEventKind kind) {
+  switch (kind) {
+  case ReplayEventKind::Seed:
+    return "seed";
+  case ReplayEventKind::Random:
+    return "random";
+  case ReplayEventKind::Allocation:
+    return "allocation";
+  case ReplayEventKind::ExternalCall:
+    return "external call";
+  case ReplayEventKind::ExternalMemory:
+    return "external memory";
+  case ReplayEventKind::Timer:
+    return "timer";
+  case ReplayEventKind::MemoryUsage:
+    return "memory usage";
+  }
+  return "unknown";
+}
+
+bool ReplayLog::startRecording(const std::string &path, std::string &error) {
+  stop();
+  output.reset(fopen(path.c_str(), "wb"));
+  if (!output) {
+    error = strerror(errno);
+    return false;
+  }
+  logPath = path;
+  buffer.assign(Magic, Magic + sizeof(Magic));
+  buffer.push_back(Version);
+  mode = Mode::Record;
+  return true;
+}
+
+bool ReplayLog::startReplaying(const std::string &path, std::string &error) {
+  stop();
+  std::unique_ptr<FILE, FileCloser> f(fopen(path.c_str(), "rb"));
+  if (!f) {
+    error = strerror(errno);
+    return false;
+  }
+  buffer.clear();
+  std::uint8_t chunk[4096];
+  std::size_t n;
+  while ((n = fread(chunk, 1, sizeof(chunk), f.get())) > 0)
+    buffer.insert(buffer.end(), chunk, chunk + n);
+  if (buffer.size() < sizeof(Magic) + 1 ||
+      memcmp(buffer.data(), Magic, sizeof(Magic)) != 0) {
+    error = "not a replay log";
+    return false;
+  }
+  if (buffer[sizeof(Magic)] != Version) {
+    error = "unsupported replay log version";
+    return false;
+  }
+  logPath = path;
+  position = sizeof(Magic) + 1;
+  numReplayed = 0;
+  mode = Mode::Replay;
+  return true;
+}
+
+void ReplayLog::stop() {
+  if (mode == Mode::Record) {
+    flush();
+    output.reset();
+  } else if (mode == Mode::Replay && position < buffer.size()) {
+    klee_warning("replay log %s: stopped after %" PRIu64
+                 " events with events left",
+                 logPath.c_str(), numReplayed);
+  }
+  mode = Mode::Off;
+  buffer.clear();
+  position = 0;
+}
+
+bool ReplayLog::isRecording() { return mode == Mode::Record; }
+
+bool ReplayLog::isReplaying() { return mode == Mode::Replay; }
+
+void ReplayLog::record(ReplayEventKind kind, std::uint64_t value,
+                       const std::vector<std::uint8_t> &data) {
+  if (mode != Mode::Record)
+    return;
+  buffer.push_back(std::uint8_t(kind) | (data.empty() ? 0 : HasData));
+  putVarint(value);
+  if (!data.empty()) {
+    putVarint(data.size());
+    buffer.insert(buffer.end(), data.begin(), data.end());
+  }
+  if (buffer.size() >= FlushSize)
+    flush();
+}
+
+bool ReplayLog::peek(ReplayEventKind kind, std::uint64_t &value) {
+  if (mode != Mode::Replay)
+    return false;
+  std::size_t at = position;
+  ReplayEventKind next;
+  return decode(at, next, value, nullptr) && next == kind;
+}
+
+std::uint64_t ReplayLog::replay(ReplayEventKind kind,
+                                std::vector<std::uint8_t> *data) {
+  assert(mode == Mode::Replay && "not replaying");
+  ReplayEventKind next;
+  std::uint64_t value;
+  if (!decode(position, next, value, data))
+    klee_error("replay log %s: run diverged after %" PRIu64
+               " events, the log ended before a %s event",
+               logPath.c_str(), numReplayed, getReplayEventKindName(kind));
+  if (next != kind)
+    klee_error("replay log %s: run diverged after %" PRIu64
+               " events, expected a %s event but the log has a %s event",
+               logPath.c_str(), numReplayed, getReplayEventKindName(kind),
+               getReplayEventKindName(next));
+  ++numReplayed;
+  return value;
+}
+
+std::uint64_t ReplayLog::sync(ReplayEventKind kind, std::uint64_t value) {
+  if (mode == Mode::Replay)
+    return replay(kind);
+  record(kind, value);
+  return value;
+}
@@ -8,6 +8,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "klee/Support/ErrorHandling.h"
+#include "klee/Support/ReplayLog.h"
 #include "klee/Support/Timer.h"
 #include "klee/System/Time.h"
 
@@ -52,12 +53,19 @@ TimerGroup::TimerGroup(const time::Span &minInterval) :
     minInterval,
     [&]{
       // invoke timers
-      for (auto &timer : timers)
-        timer->invoke(currentTime);
+      for (unsigned i = 0; i < timers.size(); ++i) {
+        // log the firing before the callback, which may log events itself
+        if (currentTime >= timers[i]->nextInvocationTime)
+          ReplayLog::record(ReplayEventKind::Timer, (invocations << 8) | i);
+        timers[i]->invoke(currentTime);
+      }
     }
   } {};
 
 void TimerGroup::add(std::unique_ptr<klee::Timer> timer) {
+  if (timers.size() == 256)
+    klee_error("Too many timers");
+
   const auto &interval = timer->getInterval();
   const auto &minInterval = invocationTimer.getInterval();
   if (interval < minInterval)
@@ -69,6 +77,20 @@ void TimerGroup::add(std::unique_ptr<klee::Timer> timer) {
 }
 
 void TimerGroup::invoke() {
+  ++invocations;
+  if (ReplayLog::isReplaying()) {
+    std::uint64_t event;
+    while (ReplayLog::peek(ReplayEventKind::Timer, event) &&
+           event >> 8 == invocations) {
+      ReplayLog::replay(ReplayEventKind::Timer);
+      std::size_t i = event & 0xff;
+      if (i >= timers.size())
+        klee_error("replay log fires unknown timer %zu", i);
+      timers[i]->run();
+    }
+    return;
+  }
+
   currentTime = time::getWallTime();
   invocationTimer.invoke(currentTime);
 }
@@ -0,0 +1,72 @@
+#!/usr/bin/env python3
+
+# ===-- klee-bench-compare.py ---------------------------------------------===##
+#
+#                      The KLEE Symbolic Virtual Machine
+#
+#  This file is distributed under the University of Illinois Open Source
+#  License. See LICENSE.TXT for details.
+#
+# ===----------------------------------------------------------------------===##
+
+"""Compare two results of klee-bench --json or klee-e2e-bench.py.
+
+Exits with status 1 if a benchmark of the current results is worse than the
+baseline by more than the threshold.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(path, metric):
+    with open(path) as f:
+        results = json.load(f)
+    return {b['name']: b[metric] for b in results['benchmarks']
+            if b.get(metric) is not None}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument('baseline', help='JSON results of the baseline')
+    parser.add_argument('current', help='JSON results to compare')
+    parser.add_argument('--threshold', type=float, default=10.0,
+                        help='allowed regression in percent (default: 10)')
+    parser.add_argument('--metric', default='ns_per_op_min',
+                        help='field to compare, e.g. ns_per_op_median or '
+                             'instructions_per_sec (default: ns_per_op_min)')
+    parser.add_argument('--higher-is-better', action='store_true',
+                        help='the metric is a throughput rather than a cost')
+    args = parser.parse_args()
+
+    baseline = load(args.baseline, args.metric)
+    current = load(args.current, args.metric)
+
+    regressions = 0
+    print('{:<32} {:>12} {:>12} {:>9}'.format('benchmark', 'baseline',
+                                              'current', 'change'))
+    for name in sorted(set(baseline) | set(current)):
+        if name not in baseline or name not in current:
+            side = 'baseline' if name not in baseline else 'current'
+            print('{:<32} (missing from {})'.format(name, side))
+            continue
+        old, new = baseline[name], current[name]
+        change = (new - old) / old * 100 if old else 0.0
+        worse = -change if args.higher_is_better else change
+        flag = ''
+        if worse > args.threshold:
+            flag = '  REGRESSION'
+            regressions += 1
+        print('{:<32} {:>12.2f} {:>12.2f} {:>+8.1f}%{}'.format(
+            name, old, new, change, flag))
+
+    if regressions:
+        print('{} benchmark(s) worse than the baseline by more than {}%'
+              .format(regressions, args.threshold))
+        return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,168 @@
+#!/usr/bin/env python3
+
+# ===-- klee-e2e-bench.py -------------------------------------------------===##
+#
+#                      The KLEE Symbolic Virtual Machine
+#
+#  This file is distributed under the University of Illinois Open Source
+#  License. See LICENSE.TXT for details.
+#
+# ===----------------------------------------------------------------------===##
+
+"""End-to-end throughput benchmark of KLEE.
+
+Runs each bitcode program in symbolic mode, then in seeded concolic mode from
+the first test of the symbolic run, both with fixed budgets.  Writes a JSON
+summary of instructions/s, queries/s, solver-time share, peak RSS and
+time-to-first-test per program and mode, which klee-bench-compare.py can
+compare against a baseline.
+"""
+
+import argparse
+import glob
+import json
+import os
+import re
+import shutil
+import sqlite3
+import subprocess
+import sys
+import time
+
+
+def last_stats(out_dir):
+    """The last record of run.stats, with times in seconds"""
+    conn = sqlite3.connect(os.path.join(out_dir, 'run.stats'))
+    try:
+        cursor = conn.execute('SELECT * FROM stats ORDER BY rowid DESC LIMIT 1')
+        names = [d[0] for d in cursor.description]
+        row = cursor.fetchone()
+    finally:
+        conn.close()
+    if row is None:
+        return {}
+    record = dict(zip(names, row))
+    for key in ['WallTime', 'UserTime', 'SolverTime', 'QueryTime']:
+        record[key] /= 1000000
+    return record
+
+
+def done_counts(out_dir):
+    """The `KLEE: done:` counters of the info file"""
+    counts = {}
+    with open(os.path.join(out_dir, 'info')) as f:
+        for line in f:
+            m = re.match(r'KLEE: done: (.*) = (\d+)$', line.strip())
+            if m:
+                counts[m.group(1)] = int(m.group(2))
+    return counts
+
+
+def run_klee(klee, out_dir, args, bitcode):
+    """Runs KLEE and returns its wall time, peak RSS in KiB and start time"""
+    if os.path.exists(out_dir):
+        shutil.rmtree(out_dir)
+    command = [klee, '--output-dir=' + out_dir] + args + [bitcode]
+    start = time.time()
+    with open(os.devnull, 'w') as devnull:
+        process = subprocess.Popen(command, stdout=devnull, stderr=devnull)
+        _, status, usage = os.wait4(process.pid, 0)
+        process.returncode = status
+    wall = time.time() - start
+    if status != 0:
+        raise RuntimeError('{} failed with status {}'.format(
+            ' '.join(command), status))
+    return wall, usage.ru_maxrss, start
+
+
+def measure(name, klee, out_dir, args, bitcode):
+    wall, rss, start = run_klee(klee, out_dir, args, bitcode)
+    stats = last_stats(out_dir)
+    counts = done_counts(out_dir)
+    tests = sorted(glob.glob(os.path.join(out_dir, 'test*.ktest')))
+    first = min((os.path.getmtime(t) for t in tests), default=None)
+
+    klee_wall = stats.get('WallTime') or wall
+    result = {
+        'name': name,
+        'wall_time': round(wall, 3),
+        'instructions': counts.get('total instructions', 0),
+        'queries': counts.get('total queries', 0),
+        'completed_paths': counts.get('completed paths', 0),
+        'tests': len(tests),
+        'instructions_per_sec': round(
+            counts.get('total instructions', 0) / klee_wall, 1),
+        'queries_per_sec': round(counts.get('total queries', 0) / klee_wall, 1),
+        'solver_time_share': round(stats.get('SolverTime', 0) / klee_wall, 4),
+        'peak_rss_kb': rss,
+        'time_to_first_test': (round(max(first - start, 0), 3)
+                               if first is not None else None),
+    }
+    return result, tests
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument('programs', nargs='+', metavar='program.bc',
+                        help='bitcode programs to run')
+    parser.add_argument('--klee', default='klee', help='KLEE binary')
+    parser.add_argument('--output', default='klee-e2e-bench.json',
+                        help='JSON summary to write '
+                             '(default: klee-e2e-bench.json)')
+    parser.add_argument('--work-dir', default='klee-e2e-bench.out',
+                        help='directory for the KLEE output directories '
+                             '(default: klee-e2e-bench.out)')
+    parser.add_argument('--max-time', default='30s',
+                        help='time budget of each run (default: 30s)')
+    parser.add_argument('--max-instructions', type=int, default=0,
+                        help='instruction budget of each run (default: none)')
+    parser.add_argument('--concolic-runs', type=int, default=32,
+                        help='concolic runs of the seeded mode (default: 32)')
+    parser.add_argument('--klee-arg', action='append', default=[],
+                        help='additional argument for every KLEE run')
+    args = parser.parse_args()
+
+    budget = ['--max-time=' + args.max_time] + args.klee_arg
+    if args.max_instructions:
+        budget.append('--max-instructions={}'.format(args.max_instructions))
+
+    os.makedirs(args.work_dir, exist_ok=True)
+    results = []
+    for bitcode in args.programs:
+        program = os.path.splitext(os.path.basename(bitcode))[0]
+        out_dir = os.path.join(args.work_dir, program)
+
+        result, tests = measure(program + '/symbolic', args.klee,
+                                out_dir + '-symbolic', budget, bitcode)
+        results.append(result)
+        print(json.dumps(result))
+        if not tests:
+            print('{}: no test to seed the concolic run'.format(program),
+                  file=sys.stderr)
+            continue
+
+        concolic = budget + ['--seed-file=' + tests[0],
+                             '--concolic-runs={}'.format(args.concolic_runs)]
+        result, _ = measure(program + '/concolic', args.klee,
+                            out_dir + '-concolic', concolic, bitcode)
+        results.append(result)
+        print(json.dumps(result))
+
+    summary = {
+        'context': {
+            'klee': args.klee,
+            'max_time': args.max_time,
+            'max_instructions': args.max_instructions,
+            'concolic_runs': args.concolic_runs,
+            'klee_args': args.klee_arg,
+        },
+        'benchmarks': results,
+    }
+    with open(args.output, 'w') as f:
+        json.dump(summary, f, indent=2)
+        f.write('\n')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
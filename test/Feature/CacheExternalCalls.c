@@ -0,0 +1,21 @@
+// RUN: %clang %s -emit-llvm -g -c -o %t.bc
+// RUN: rm -rf %t.klee-out
+// RUN: %klee --output-dir=%t.klee-out --cache-external-calls=strlen %t.bc 2>&1 | FileCheck %s
+// CHECK-NOT: ASSERTION FAIL
+// CHECK: KLEE: done: completed paths = 1
+
+#include <assert.h>
+#include <string.h>
+
+int main() {
+  char buffer[8] = "abc";
+  size_t total = 0;
+  for (int i = 0; i < 100; ++i)
+    total += strlen(buffer);
+  assert(total == 300);
+
+  // The contents of the argument are part of the key
+  buffer[3] = 'd';
+  assert(strlen(buffer) == 4);
+  return 0;
+}
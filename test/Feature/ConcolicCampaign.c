@@ -0,0 +1,23 @@
+// RUN: %clang %s -emit-llvm -g -c -DMAKE_SEED -o %t1.bc
+// RUN: %clang %s -emit-llvm -g -c -o %t2.bc
+// RUN: rm -rf %t.klee-seed %t.klee-out
+// RUN: %klee --output-dir=%t.klee-seed %t1.bc
+// RUN: %klee --output-dir=%t.klee-out --seed-file=%t.klee-seed/test000001.ktest --concolic-runs=8 %t2.bc 2>&1 | FileCheck %s
+// CHECK: concolic run 2 (generation 1)
+// CHECK: ASSERTION FAIL
+// RUN: ls %t.klee-out | FileCheck --check-prefix=CHECK-ERR %s
+// CHECK-ERR: .assert.err
+
+#include <assert.h>
+
+int main() {
+  char x[4];
+  klee_make_symbolic(x, sizeof(x), "x");
+#ifndef MAKE_SEED
+  if (x[0] == 'b')
+    if (x[1] == 'u')
+      if (x[2] == 'g')
+        assert(0);
+#endif
+  return 0;
+}
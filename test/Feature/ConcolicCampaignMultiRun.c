@@ -0,0 +1,29 @@
+// RUN: %clang %s -emit-llvm -g -c -DMAKE_SEED -o %t1.bc
+// RUN: %clang %s -emit-llvm -g -c -o %t2.bc
+// RUN: rm -rf %t.klee-seed %t.klee-out
+// RUN: %klee --output-dir=%t.klee-seed %t1.bc
+// RUN: %klee --output-dir=%t.klee-out --use-constant-arrays=false --seed-file=%t.klee-seed/test000001.ktest --concolic-runs=16 %t2.bc 2>&1 | FileCheck %s
+// CHECK: concolic run 2 (generation 1)
+// CHECK: concolic run 3 (generation 2)
+// CHECK: concolic run 4 (generation 3)
+// CHECK: ASSERTION FAIL
+// RUN: ls %t.klee-out | FileCheck --check-prefix=CHECK-ERR %s
+// CHECK-ERR: .assert.err
+//
+// Every run allocates fresh objects, which without constant arrays are
+// backed by symbolic arrays from the memory manager's array cache.
+
+#include <assert.h>
+
+int main() {
+  char x[4];
+  klee_make_symbolic(x, sizeof(x), "x");
+#ifndef MAKE_SEED
+  char table[4] = {'b', 'u', 'g', '!'};
+  if (x[0] == table[0])
+    if (x[1] == table[1])
+      if (x[2] == table[2])
+        assert(0);
+#endif
+  return 0;
+}
@@ -0,0 +1,24 @@
+// RUN: %clang %s -emit-llvm %O0opt -g -c -o %t.bc
+// RUN: rm -rf %t.klee-out
+// RUN: %klee --output-dir=%t.klee-out --expr-stats --dump-expr-profile %t.bc
+// RUN: FileCheck %s -input-file=%t.klee-out/expr-profile.txt
+// RUN: %klee-stats --print-all --to-csv %t.klee-out | FileCheck %s -check-prefix=CHECK-STATS
+
+#include "klee/klee.h"
+
+int main(void) {
+  unsigned char buf[8];
+  klee_make_symbolic(buf, sizeof(buf), "buf");
+
+  // The hash is the largest expression, computed on this line
+  // CHECK: # tree size
+  // CHECK-NEXT: {{[0-9]+}}	{{[0-9]+}}	{{[A-Za-z]+}}	{{[0-9]+}}	{{.*}}ExprProfile.c:[[@LINE+3]]	main	add
+  unsigned hash = 0;
+  for (unsigned i = 0; i < 8; ++i)
+    hash = hash * 31 + buf[i];
+
+  // CHECK-STATS: LiveExprs,ArrayCacheSize,ConstraintExprs,ConstraintDepth,ConstraintSharing,MaxUpdateListLength
+  if (buf[0] == 'a')
+    return 1;
+  return 0;
+}
@@ -0,0 +1,30 @@
+// RUN: %clang %s -emit-llvm -g -c -DMAKE_SEED -o %t1.bc
+// RUN: %clang %s -emit-llvm -g -c -o %t2.bc
+// RUN: rm -rf %t.klee-seed %t.klee-out
+// RUN: %klee --output-dir=%t.klee-seed %t1.bc
+// RUN: %klee --output-dir=%t.klee-out --seed-file=%t.klee-seed/test000001.ktest --flip-branches %t2.bc 2>&1 | FileCheck %s
+// CHECK: wrote 2 flipped seeds for 2 symbolic branches
+// RUN: test -f %t.klee-out/flip000001.ktest
+// RUN: test -f %t.klee-out/flip000002.ktest
+// RUN: not test -f %t.klee-out/flip000003.ktest
+
+// The second seed follows the first branch and the flipped second one
+// without the solver
+// RUN: rm -rf %t.klee-prefix
+// RUN: %klee --output-dir=%t.klee-prefix --seed-file=%t.klee-out/flip000002.ktest --seed-prefix=%t.klee-out/flip000002.prefix %t2.bc 2>&1 | FileCheck --check-prefix=CHECK-PREFIX %s
+// CHECK-PREFIX: followed 2 branches of the seed prefix without the solver
+// CHECK-PREFIX-NOT: diverged
+
+#include <stdio.h>
+
+int main() {
+  int x;
+  klee_make_symbolic(&x, sizeof(x), "x");
+#ifndef MAKE_SEED
+  if (x < 10)
+    printf("small\n");
+  if (x % 2)
+    printf("odd\n");
+#endif
+  return 0;
+}
@@ -0,0 +1,21 @@
+// RUN: %clang %s -emit-llvm %O0opt -g -c -o %t.bc
+// RUN: rm -rf %t.klee-out
+// RUN: %klee --output-dir=%t.klee-out --native-leaf-functions %t.bc 2>&1 | FileCheck %s
+
+// Interpreted: the write is out of bounds of buf, which natively would
+// silently overwrite another stack slot
+unsigned overflow(unsigned value) {
+  unsigned buf[2] = {0, 0};
+  buf[2] = value;
+  return buf[0];
+}
+
+// Interpreted: the shift amount is not a constant
+unsigned shift(unsigned value, unsigned amount) { return value << amount; }
+
+int main(void) {
+  // CHECK: KLEE: running {{[0-9]+}} functions natively on concrete arguments
+  shift(1, 3);
+  // CHECK: KLEE: ERROR: {{.*}}NativeLeafFunctionsBounds.c:9: memory error: out of bound pointer
+  return overflow(7);
+}
@@ -0,0 +1,39 @@
+// Divisions and shifts whose operand is known to be in range are not
+// instrumented, and checks proven at run time for every path are skipped.
+//
+// RUN: %clang %s -emit-llvm %O0opt -g -c -o %t.bc
+// RUN: rm -rf %t.klee-out
+// RUN: %klee --output-dir=%t.klee-out --check-div-zero --check-overshift %t.bc 2>&1 | FileCheck %s -check-prefix=CHECK-RUN
+// RUN: FileCheck %s -input-file=%t.klee-out/assembly.ll -check-prefix=CHECK-ASM
+// RUN: rm -rf %t.klee-out
+// RUN: %klee --output-dir=%t.klee-out --check-div-zero --check-overshift --skip-proven-checks=false %t.bc 2>&1 | FileCheck %s -check-prefix=CHECK-RUN
+
+#include "klee/klee.h"
+
+int main(int argc, char **argv) {
+  unsigned char c;
+  klee_make_symbolic(&c, sizeof(c), "c");
+
+  // CHECK-ASM-LABEL: define {{.*}}@main(
+  // CHECK-ASM-NOT: !klee.check
+  // CHECK-ASM-NOT: call {{.*}}void @klee_overshift_check
+  unsigned nonZero = argc / (c | 1u);
+
+  unsigned inRange = (unsigned)argc >> (c & 7u);
+
+  // Not known statically as the divisor goes through memory, but the
+  // condition holds without any path constraint
+  // CHECK-ASM: call {{.*}}void @klee_div_zero_check
+  // CHECK-ASM: udiv {{.*}} !klee.check.div
+  unsigned divisor = c + 1u;
+  unsigned viaMemory = argc / divisor;
+
+  // CHECK-ASM: call {{.*}}void @klee_div_zero_check
+  // CHECK-ASM: udiv {{.*}} !klee.check.div
+  // CHECK-RUN: divide by zero
+  unsigned mayBeZero = argc / c;
+
+  // CHECK-RUN: KLEE: done: completed paths = 1
+  // CHECK-RUN: KLEE: done: generated tests = 2
+  return nonZero + inRange + viaMemory + mayBeZero;
+}
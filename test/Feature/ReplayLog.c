@@ -0,0 +1,34 @@
+// RUN: %clang %s -emit-llvm %O0opt -g -c -o %t.bc
+// RUN: rm -rf %t.klee-record %t.klee-replay
+// RUN: %klee --output-dir=%t.klee-record --record-log --write-paths %t.bc 2>&1 | FileCheck --check-prefix=CHECK-RECORD %s
+// RUN: %klee --output-dir=%t.klee-replay --replay-log=%t.klee-record/replay.log --write-paths %t.bc 2>&1 | FileCheck --check-prefix=CHECK-REPLAY %s
+// CHECK-RECORD: KLEE: done: generated tests = 2
+// CHECK-REPLAY-NOT: ERROR
+// CHECK-REPLAY: KLEE: done: generated tests = 2
+//
+// The replayed run takes the same paths and, as the replayed getpid()
+// returns the recorded process id, generates the same inputs
+// RUN: diff %t.klee-record/test000001.path %t.klee-replay/test000001.path
+// RUN: diff %t.klee-record/test000002.path %t.klee-replay/test000002.path
+// RUN: %ktest-tool %t.klee-record/test000001.ktest | tail -n +2 > %t.record1
+// RUN: %ktest-tool %t.klee-replay/test000001.ktest | tail -n +2 > %t.replay1
+// RUN: diff %t.record1 %t.replay1
+// RUN: %ktest-tool %t.klee-record/test000002.ktest | tail -n +2 > %t.record2
+// RUN: %ktest-tool %t.klee-replay/test000002.ktest | tail -n +2 > %t.replay2
+// RUN: diff %t.record2 %t.replay2
+
+#include "klee/klee.h"
+
+#include <stdio.h>
+#include <unistd.h>
+
+int main(void) {
+  unsigned x;
+  klee_make_symbolic(&x, sizeof(x), "x");
+  unsigned pid = getpid();
+  if (x < pid)
+    printf("below\n");
+  else
+    printf("above\n");
+  return x == pid;
+}
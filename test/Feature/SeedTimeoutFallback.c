@@ -0,0 +1,26 @@
+// RUN: %clang %s -emit-llvm -g -c -DMAKE_SEED -o %t1.bc
+// RUN: %clang %s -emit-llvm -g -c -o %t2.bc
+// RUN: rm -rf %t.klee-seed %t.klee-out
+// RUN: %klee --output-dir=%t.klee-seed %t1.bc
+// The dummy solver fails every query, as a timeout would
+// RUN: %klee --output-dir=%t.klee-out --solver-backend=dummy --seed-file=%t.klee-seed/test000001.ktest --allow-seed-extension --seed-timeout-fallback --log-ppc %t2.bc 2>&1 | FileCheck %s
+// CHECK: solver timed out, following the seed
+// CHECK: ASSERTION FAIL
+// RUN: FileCheck --check-prefix=CHECK-PPC %s < %t.klee-out/ppc.log
+// CHECK-PPC: [path:ppc:dropped] {{.*}}SeedTimeoutFallback.c:{{[0-9]+}} : (Eq 0 (Read w8 {{[0-3]}} y))
+
+#include "klee/klee.h"
+
+#include <assert.h>
+
+int main() {
+  int x, y = 0;
+  klee_make_symbolic(&x, sizeof(x), "x");
+#ifndef MAKE_SEED
+  // Not in the seed, its value is solved for
+  klee_make_symbolic(&y, sizeof(y), "y");
+  if (x + y == 0)
+    assert(0);
+#endif
+  return 0;
+}
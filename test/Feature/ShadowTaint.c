@@ -0,0 +1,43 @@
+// RUN: %clang %s -emit-llvm %O0opt -g -c -o %t.bc
+// RUN: rm -rf %t.klee-out
+// RUN: %klee --output-dir=%t.klee-out --shadow-taint %t.bc 2>&1 | FileCheck %s
+// RUN: test -f %t.klee-out/taint.idx
+
+#include "klee/klee.h"
+
+int stored;
+
+int twice(int value) { return value * 2; }
+
+int main(void) {
+  char x[4];
+  klee_make_symbolic(x, sizeof(x), "x");
+
+  // CHECK: operands:{{-?[0-9]+}} taint:{x[0] x[1]}
+  klee_print_expr("operands", x[0] + x[1]);
+
+  // Through memory
+  stored = x[1];
+  // CHECK: memory:{{-?[0-9]+}} taint:{x[1]}
+  klee_print_expr("memory", stored);
+
+  // Through a call and its return
+  // CHECK: call:{{-?[0-9]+}} taint:{x[2]}
+  klee_print_expr("call", twice(x[2]));
+
+  // Only explicit flows are tracked, so the value assigned on either side of
+  // a branch on x[3] does not depend on x[3]
+  int y;
+  if (x[3] & 1)
+    y = x[0] + 1;
+  else
+    y = x[0] - 1;
+  // CHECK: branch:{{-?[0-9]+}} taint:{x[0]}
+  klee_print_expr("branch", y);
+
+  // CHECK: untainted:7 taint:{}
+  klee_print_expr("untainted", 7);
+
+  // CHECK: KLEE: done: completed paths = 1
+  return 0;
+}
@@ -0,0 +1,37 @@
+// RUN: %clang %s -emit-llvm %O0opt -g -c -o %t.bc
+// RUN: rm -rf %t.klee-out
+// RUN: %klee --output-dir=%t.klee-out %t.bc 2>&1 | FileCheck %s -check-prefix=CHECK-CALLS
+// RUN: rm -rf %t.klee-out
+// RUN: %klee --output-dir=%t.klee-out --skip-output-calls %t.bc 2>&1 | FileCheck %s -check-prefix=CHECK-SKIP
+
+#include "klee/klee.h"
+
+#include <stdio.h>
+
+int counter;
+
+void log_value(int x) {
+  int copy = x;
+  printf("x = %d\n", copy);
+}
+
+void count(void) {
+  ++counter;
+  printf("counted\n");
+}
+
+int main(void) {
+  int x;
+  klee_make_symbolic(&x, sizeof(x), "x");
+
+  // CHECK-CALLS: external call with symbolic argument: printf
+  // CHECK-SKIP: skipping the calls to {{[0-9]+}} output-only functions
+  // CHECK-SKIP-NOT: external call with symbolic argument
+  log_value(x);
+
+  // Writes a global, so it is executed
+  count();
+
+  // CHECK-SKIP: KLEE: done: completed paths = 1
+  return counter == 1 ? 0 : 1;
+}
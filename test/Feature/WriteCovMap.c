@@ -0,0 +1,23 @@
+// RUN: %clang %s -emit-llvm -g -c -o %t2.bc
+// RUN: rm -rf %t.klee-out %t.covmap
+// RUN: %klee --output-dir=%t.klee-out --write-cov-map --cov-map-size=1024 %t2.bc
+// RUN: test -f %t.klee-out/test000001.covmap
+// RUN: test -f %t.klee-out/test000002.covmap
+// RUN: %klee-cov-merge --print-new -o %t.covmap %t.klee-out | FileCheck %s
+// CHECK: test000001.covmap: {{[0-9]+}} new
+// CHECK: test000002.covmap: {{[0-9]+}} new
+// CHECK: Edges:
+// RUN: %klee-cov-merge --print-new -o %t.covmap %t.klee-out/test000001.covmap | FileCheck --check-prefix=CHECK-MERGED %s
+// CHECK-MERGED-NOT: new
+// CHECK-MERGED: Edges:
+
+#include <stdio.h>
+
+int main() {
+  if (klee_range(0, 2, "range")) {
+    printf("one\n");
+  } else {
+    printf("zero\n");
+  }
+  return 0;
+}
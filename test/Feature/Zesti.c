@@ -0,0 +1,32 @@
+// RUN: %clang %s -emit-llvm -g -c -DMAKE_SEED -o %t1.bc
+// RUN: %clang %s -emit-llvm -g -c -o %t2.bc
+// RUN: rm -rf %t.klee-seed %t.klee-out
+// RUN: %klee --output-dir=%t.klee-seed %t1.bc
+// RUN: %klee --output-dir=%t.klee-out --seed-file=%t.klee-seed/test000001.ktest --concolic-runs=4 --zesti %t2.bc 2>&1 | FileCheck %s
+// CHECK: zesti run 2: negating branch at {{.*}}Zesti.c:[[@LINE+16]], 1 branches before a sensitive operation
+// CHECK: memory error: out of bound pointer
+// CHECK-NOT: zesti run 3
+// RUN: ls %t.klee-out | FileCheck --check-prefix=CHECK-ERR %s
+// CHECK-ERR: .ptr.err
+
+#include <stdio.h>
+
+int table[4] = {1, 2, 3, 4};
+
+int main() {
+  unsigned char x[4];
+  klee_make_symbolic(x, sizeof(x), "x");
+#ifndef MAKE_SEED
+  unsigned i = x[1] & 3;
+  // The only branch followed by a symbolic table index
+  if (x[0] == 'b') {
+    putchar('b');
+    i += 4;
+  }
+  int v = table[i];
+  if (x[1] == 7)
+    putchar('7');
+  return v;
+#endif
+  return 0;
+}
@@ -0,0 +1,552 @@
+//===-- main.cpp ------------------------------------------------*- C++ -*-===//
+//
+//                     The KLEE Symbolic Virtual Machine
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// Micro-benchmarks for the hot paths of the executor: expression
+// construction, ExprHashMap, ObjectState reads and writes,
+// AddressSpace::resolveOne and the interpreter loop.  The results are
+// printed as a table and optionally written as JSON, to be compared against
+// a baseline with scripts/klee-bench-compare.py.
+//
+//===----------------------------------------------------------------------===//
+
+#include "Core/AddressSpace.h"
+#include "Core/Context.h"
+#include "Core/CoreStats.h"
+#include "Core/Memory.h"
+#include "Core/MemoryManager.h"
+
+#include "klee/ADT/RNG.h"
+#include "klee/Config/Version.h"
+#include "klee/Core/Interpreter.h"
+#include "klee/Expr/ArrayCache.h"
+#include "klee/Expr/Expr.h"
+#include "klee/Expr/ExprBuilder.h"
+#include "klee/Expr/ExprHashMap.h"
+#include "klee/Expr/Parser/Parser.h"
+#include "klee/Support/ErrorHandling.h"
+#include "klee/Support/FileHandling.h"
+#include "klee/Support/PrintVersion.h"
+
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/TargetSelect.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace llvm;
+using namespace klee;
+
+namespace {
+using klee::ConstantExpr;
+
+cl::OptionCategory BenchCat("Benchmark options");
+
+cl::opt<std::string> Filter(
+    "filter",
+    cl::desc("Only run the benchmarks whose name contains this string"),
+    cl::cat(BenchCat));
+
+cl::opt<unsigned> Repetitions(
+    "repetitions",
+    cl::desc("Number of timed repetitions of each benchmark (default=5)"),
+    cl::init(5), cl::cat(BenchCat));
+
+cl::opt<unsigned> Scale(
+    "scale",
+    cl::desc("Multiplier for the amount of work in each repetition "
+             "(default=1)"),
+    cl::init(1), cl::cat(BenchCat));
+
+cl::opt<std::string> JSONFile(
+    "json", cl::desc("Write the results as JSON to the given file"),
+    cl::cat(BenchCat));
+
+cl::opt<std::string> KQueryFile(
+    "kquery",
+    cl::desc("Benchmark the expressions of a recorded run, e.g. the "
+             "all-queries.kquery written with --write-kqueries, instead of "
+             "synthetic ones"),
+    cl::cat(BenchCat));
+
+cl::opt<bool> SkipInterpreter(
+    "skip-interpreter",
+    cl::desc("Do not benchmark the interpreter, which needs the runtime "
+             "library (default=false)"),
+    cl::init(false), cl::cat(BenchCat));
+
+/// One benchmark: `run` performs a repetition and returns the number of
+/// operations it performed
+struct Benchmark {
+  std::string name;
+  std::function<std::uint64_t()> run;
+};
+
+struct Result {
+  std::string name;
+  std::uint64_t operations;
+  double minNs;
+  double medianNs;
+};
+
+Result measure(const Benchmark &b) {
+  b.run(); // warm up caches and allocators
+
+  std::uint64_t operations = 0;
+  std::vector<double> nsPerOp;
+  for (unsigned i = 0; i < std::max(1u, Repetitions.getValue()); ++i) {
+    auto start = std::chrono::steady_clock::now();
+    operations = b.run();
+    auto end = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    nsPerOp.push_back(ns / std::max<std::uint64_t>(operations, 1));
+  }
+  std::sort(nsPerOp.begin(), nsPerOp.end());
+  return {b.name, operations, nsPerOp.front(), nsPerOp[nsPerOp.size() / 2]};
+}
+
+/*** Expressions ***/
+
+/// Expressions to benchmark: either a recorded run's query expressions or a
+/// synthetic corpus shaped like the reads and arithmetic of a typical
+/// program
+class Corpus {
+  ArrayCache arrayCache;
+  std::unique_ptr<ExprBuilder> builder;
+  std::unique_ptr<MemoryBuffer> buffer;
+  std::unique_ptr<expr::Parser> parser;
+
+public:
+  std::vector<ref<Expr>> exprs;
+
+  void load(const std::string &path) {
+    auto mb = MemoryBuffer::getFileOrSTDIN(path);
+    if (!mb)
+      klee_error("unable to read %s: %s", path.c_str(),
+                 mb.getError().message().c_str());
+    buffer = std::move(*mb);
+    builder.reset(createDefaultExprBuilder());
+    parser.reset(expr::Parser::Create(path, buffer.get(), builder.get(),
+                                      /*ClearArrayAfterQuery=*/false));
+    while (expr::Decl *d = parser->ParseTopLevelDecl()) {
+      if (auto qc = dyn_cast<expr::QueryCommand>(d)) {
+        exprs.insert(exprs.end(), qc->Constraints.begin(),
+                     qc->Constraints.end());
+        exprs.push_back(qc->Query);
+      }
+    }
+    if (unsigned n = parser->GetNumErrors())
+      klee_error("%s: parse failure: %u errors", path.c_str(), n);
+    if (exprs.empty())
+      klee_error("%s: no queries", path.c_str());
+  }
+
+  void synthesize(unsigned count) {
+    RNG rng;
+    const Array *array = arrayCache.CreateArray("input", 64);
+    UpdateList ul(array, 0);
+    for (unsigned i = 0; i < count; ++i) {
+      // Little-endian 32-bit load from the input, then a short chain of
+      // arithmetic and a comparison, as a branch condition would be
+      unsigned offset = rng.getInt32() % 60;
+      ref<Expr> value = ReadExpr::create(ul, ConstantExpr::create(offset, 32));
+      for (unsigned b = 1; b < 4; ++b)
+        value = ConcatExpr::create(
+            ReadExpr::create(ul, ConstantExpr::create(offset + b, 32)), value);
+      for (unsigned j = rng.getInt32() % 8; j > 0; --j) {
+        ref<Expr> c = ConstantExpr::create(rng.getInt32() % 1000 + 1, 32);
+        switch (rng.getInt32() % 4) {
+        case 0: value = AddExpr::create(value, c); break;
+        case 1: value = MulExpr::create(value, c); break;
+        case 2: value = XorExpr::create(value, c); break;
+        default: value = AndExpr::create(value, c); break;
+        }
+      }
+      exprs.push_back(UltExpr::create(
+          value, ConstantExpr::create(rng.getInt32() % 100000, 32)));
+    }
+  }
+};
+
+/// Rebuilds e bottom up with Expr::create*, sharing common subexpressions
+ref<Expr> rebuild(const ref<Expr> &e, ExprHashMap<ref<Expr>> &done) {
+  if (isa<ConstantExpr>(e))
+    return e;
+  auto it = done.find(e);
+  if (it != done.end())
+    return it->second;
+  ref<Expr> kids[8];
+  unsigned n = e->getNumKids();
+  assert(n <= 8);
+  for (unsigned i = 0; i < n; ++i)
+    kids[i] = rebuild(e->getKid(i), done);
+  ref<Expr> result = e->rebuild(kids);
+  done.insert(std::make_pair(e, result));
+  return result;
+}
+
+void addExprBenchmarks(std::vector<Benchmark> &benchmarks,
+                       const Corpus &corpus) {
+  benchmarks.push_back({"expr/create-chain", [] {
+    ArrayCache ac;
+    UpdateList ul(ac.CreateArray("x", 16), 0);
+    std::uint64_t n = 20000 * Scale;
+    ref<Expr> e = ConstantExpr::create(0, 32);
+    for (std::uint64_t i = 0; i < n; ++i) {
+      ref<Expr> x = ZExtExpr::create(
+          ReadExpr::create(ul, ConstantExpr::create(i & 15, 32)), 32);
+      e = AddExpr::create(MulExpr::create(e, ConstantExpr::create(3, 32)), x);
+      if ((i & 63) == 63) // keep the DAG depth realistic
+        e = ConstantExpr::create(i, 32);
+    }
+    return n;
+  }});
+
+  benchmarks.push_back({"expr/rebuild-corpus", [&corpus] {
+    std::uint64_t nodes = 0;
+    for (unsigned r = 0; r < Scale; ++r) {
+      ExprHashMap<ref<Expr>> done;
+      for (const ref<Expr> &e : corpus.exprs)
+        rebuild(e, done);
+      nodes += done.size();
+    }
+    return nodes;
+  }});
+
+  benchmarks.push_back({"exprhashmap/insert-find", [&corpus] {
+    std::uint64_t operations = 0;
+    for (unsigned r = 0; r < 4 * Scale; ++r) {
+      ExprHashMap<unsigned> map;
+      for (const ref<Expr> &e : corpus.exprs)
+        map.insert(std::make_pair(e, 0u));
+      for (const ref<Expr> &e : corpus.exprs)
+        map[e] += map.count(e);
+      operations += 2 * corpus.exprs.size();
+    }
+    return operations;
+  }});
+}
+
+/*** Memory ***/
+
+const unsigned ObjectSize = 4096;
+
+/// A global object owned by `memory`, whose array cache holds the arrays of
+/// flushed reads
+MemoryObject *createObject(MemoryManager &memory, uint64_t address,
+                           unsigned size) {
+  return new MemoryObject(address, size, /*isLocal=*/false, /*isGlobal=*/true,
+                          /*isFixed=*/true, nullptr, &memory);
+}
+
+void addMemoryBenchmarks(std::vector<Benchmark> &benchmarks,
+                         MemoryManager &memory) {
+  benchmarks.push_back({"objectstate/concrete-rw", [&memory] {
+    ref<MemoryObject> mo(createObject(memory, 0x10000, ObjectSize));
+    ObjectState os(mo.get());
+    os.initializeToZero();
+    std::uint64_t n = 0;
+    for (unsigned r = 0; r < 8 * Scale; ++r) {
+      // Sequential, then strided accesses of 32-bit words
+      for (unsigned stride : {4u, 68u}) {
+        for (unsigned i = 0; i < ObjectSize / 4; ++i, n += 2) {
+          unsigned offset = (i * stride) % (ObjectSize - 4);
+          ref<Expr> v = os.read(offset, Expr::Int32);
+          os.write(offset, AddExpr::create(v, ConstantExpr::create(1, 32)));
+        }
+      }
+    }
+    return n;
+  }});
+
+  benchmarks.push_back({"objectstate/symbolic-rw", [&memory] {
+    ArrayCache ac;
+    ref<MemoryObject> mo(createObject(memory, 0x10000, ObjectSize));
+    ObjectState os(mo.get(), ac.CreateArray("buffer", ObjectSize));
+    std::uint64_t n = 0;
+    for (unsigned r = 0; r < 2 * Scale; ++r) {
+      for (unsigned i = 0; i < ObjectSize / 4; ++i, n += 2) {
+        unsigned offset = (i * 4 + r * 68) % (ObjectSize - 4);
+        ref<Expr> v = os.read(offset, Expr::Int32);
+        os.write(offset, XorExpr::create(v, ConstantExpr::create(r, 32)));
+      }
+    }
+    return n;
+  }});
+
+  benchmarks.push_back({"objectstate/symbolic-offset", [&memory] {
+    ArrayCache ac;
+    const unsigned size = 256;
+    ref<MemoryObject> mo(createObject(memory, 0x10000, size));
+    std::uint64_t n = 0;
+    for (unsigned r = 0; r < 4 * Scale; ++r) {
+      // A table lookup at an input-dependent index after a few concrete
+      // stores, which are flushed into the update list
+      ObjectState os(mo.get());
+      os.initializeToZero();
+      UpdateList ul(ac.CreateArray("index" + std::to_string(r), 4), 0);
+      ref<Expr> index = ZExtExpr::create(
+          ReadExpr::create(ul, ConstantExpr::create(0, 32)), 32);
+      for (unsigned i = 0; i < 64; ++i, n += 2) {
+        os.write(i * 4 % size, ConstantExpr::create(i, 32));
+        os.read(AddExpr::create(index, ConstantExpr::create(i % 8, 32)),
+                Expr::Int8);
+      }
+    }
+    return n;
+  }});
+
+  benchmarks.push_back({"addressspace/resolve-one", [&memory] {
+    const unsigned objects = 4096;
+    AddressSpace as;
+    std::vector<uint64_t> addresses;
+    for (unsigned i = 0; i < objects; ++i) {
+      uint64_t address = 0x100000 + i * 256;
+      MemoryObject *mo = createObject(memory, address, 16 + i % 200);
+      as.bindObject(mo, new ObjectState(mo));
+      addresses.push_back(address);
+    }
+    RNG rng;
+    std::uint64_t n = 100000 * Scale, found = 0;
+    ObjectPair op;
+    for (std::uint64_t i = 0; i < n; ++i) {
+      uint64_t address = addresses[rng.getInt32() % objects] + i % 16;
+      found += as.resolveOne(ConstantExpr::create(address, 64), op);
+    }
+    if (found != n)
+      klee_error("resolveOne missed %lu addresses", (unsigned long)(n - found));
+    return n;
+  }});
+}
+
+/*** Interpreter ***/
+
+class BenchHandler : public InterpreterHandler {
+  std::string directory;
+
+public:
+  explicit BenchHandler(const std::string &directory)
+      : directory(directory) {}
+
+  llvm::raw_ostream &getInfoStream() const override { return llvm::nulls(); }
+
+  std::string getOutputFilename(const std::string &filename) override {
+    SmallString<128> path(directory);
+    sys::path::append(path, filename);
+    return path.str().str();
+  }
+
+  std::unique_ptr<llvm::raw_fd_ostream>
+  openOutputFile(const std::string &filename) override {
+    std::string error;
+    return klee_open_output_file(getOutputFilename(filename), error);
+  }
+
+  void incPathsCompleted() override {}
+  void incPathsExplored(std::uint32_t) override {}
+  void processTestCase(const ExecutionState &, const char *,
+                       const char *) override {}
+};
+
+/// main() running `iterations` iterations of an arithmetic loop whose
+/// variables live on the stack, as in unoptimized code
+std::unique_ptr<Module> createLoopModule(LLVMContext &ctx,
+                                         unsigned iterations) {
+  auto m = std::make_unique<Module>("bench", ctx);
+  m->setTargetTriple("x86_64-unknown-linux-gnu");
+  m->setDataLayout("e-m:e-i64:64-f80:128-n8:16:32:64-S128");
+
+  IRBuilder<> b(ctx);
+  Type *i32 = b.getInt32Ty();
+  Function *f = Function::Create(FunctionType::get(i32, false),
+                                 GlobalValue::ExternalLinkage, "main", m.get());
+  BasicBlock *entry = BasicBlock::Create(ctx, "entry", f);
+  BasicBlock *loop = BasicBlock::Create(ctx, "loop", f);
+  BasicBlock *exit = BasicBlock::Create(ctx, "exit", f);
+
+  b.SetInsertPoint(entry);
+  Value *i = b.CreateAlloca(i32);
+  Value *acc = b.CreateAlloca(i32);
+  b.CreateStore(b.getInt32(0), i);
+  b.CreateStore(b.getInt32(1), acc);
+  b.CreateBr(loop);
+
+  b.SetInsertPoint(loop);
+  Value *iv = b.CreateLoad(i32, i);
+  Value *accv = b.CreateLoad(i32, acc);
+  Value *next = b.CreateXor(b.CreateMul(accv, b.getInt32(31)), iv);
+  b.CreateStore(b.CreateAdd(next, b.CreateLShr(next, b.getInt32(7))), acc);
+  Value *inc = b.CreateAdd(iv, b.getInt32(1));
+  b.CreateStore(inc, i);
+  b.CreateCondBr(b.CreateICmpULT(inc, b.getInt32(iterations)), loop, exit);
+
+  b.SetInsertPoint(exit);
+  b.CreateRet(b.CreateLoad(i32, acc));
+  return m;
+}
+
+std::string getRuntimeLibraryPath() {
+  if (const char *env = getenv("KLEE_RUNTIME_LIBRARY_PATH"))
+    return env;
+  SmallString<128> libDir(KLEE_DIR);
+  sys::path::append(libDir, "runtime/lib");
+  return libDir.str().str();
+}
+
+/// State shared by the repetitions of the interpreter benchmark
+struct InterpreterBench {
+  LLVMContext ctx;
+  SmallString<128> directory;
+  std::unique_ptr<BenchHandler> handler;
+  std::unique_ptr<Interpreter> interpreter;
+  llvm::Function *main = nullptr;
+
+  bool setUp() {
+    std::string libraryDir = getRuntimeLibraryPath();
+    std::string suffix = std::string("64_") + RUNTIME_CONFIGURATION;
+    SmallString<128> intrinsic(libraryDir);
+    sys::path::append(intrinsic, "libkleeRuntimeIntrinsic" + suffix + ".bca");
+    if (!sys::fs::exists(intrinsic)) {
+      klee_warning("skipping the interpreter benchmark: %s not found",
+                   intrinsic.c_str());
+      return false;
+    }
+    if (sys::fs::createUniqueDirectory("klee-bench", directory))
+      klee_error("unable to create a temporary output directory");
+
+    std::vector<std::unique_ptr<Module>> modules;
+    modules.push_back(createLoopModule(ctx, 10000 * Scale));
+    handler = std::make_unique<BenchHandler>(directory.str().str());
+    interpreter.reset(
+        Interpreter::create(ctx, Interpreter::InterpreterOptions(),
+                            handler.get()));
+    Interpreter::ModuleOptions opts(libraryDir, "main", suffix,
+                                    /*Optimize=*/false,
+                                    /*CheckDivZero=*/false,
+                                    /*CheckOvershift=*/false);
+    main = interpreter->setModule(modules, opts)->getFunction("main");
+    return true;
+  }
+
+  ~InterpreterBench() {
+    interpreter.reset();
+    if (!directory.empty())
+      sys::fs::remove_directories(directory);
+  }
+};
+
+void addInterpreterBenchmarks(std::vector<Benchmark> &benchmarks,
+                              InterpreterBench &bench) {
+  benchmarks.push_back({"executor/execute-instruction", [&bench] {
+    char name[] = "bench";
+    char *argv[] = {name, nullptr};
+    char *envp[] = {nullptr};
+    std::uint64_t before = stats::instructions.getValue();
+    bench.interpreter->runFunctionAsMain(bench.main, 1, argv, envp);
+    return stats::instructions.getValue() - before;
+  }});
+}
+
+/*** Output ***/
+
+std::string escape(const std::string &s) {
+  std::string result;
+  for (char c : s) {
+    if (c == '"' || c == '\\')
+      result += '\\';
+    result += c;
+  }
+  return result;
+}
+
+void writeJSON(const std::string &path, const std::vector<Result> &results,
+               std::size_t corpusSize) {
+  std::error_code ec;
+  llvm::raw_fd_ostream os(path, ec, sys::fs::OF_Text);
+  if (ec)
+    klee_error("unable to write %s: %s", path.c_str(), ec.message().c_str());
+
+  os << "{\n  \"context\": {\n"
+     << "    \"version\": \"" << escape(PACKAGE_STRING) << "\",\n"
+     << "    \"build\": \"" << escape(RUNTIME_CONFIGURATION) << "\",\n"
+     << "    \"corpus\": \""
+     << escape(KQueryFile.empty() ? "synthetic" : KQueryFile.getValue())
+     << "\",\n"
+     << "    \"corpus_size\": " << corpusSize << ",\n"
+     << "    \"repetitions\": " << Repetitions << ",\n"
+     << "    \"scale\": " << Scale << "\n  },\n  \"benchmarks\": [";
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    const Result &r = results[i];
+    os << (i ? ",\n" : "\n") << "    {\"name\": \"" << escape(r.name)
+       << "\", \"operations\": " << r.operations
+       << ", \"ns_per_op_min\": " << format("%.3f", r.minNs)
+       << ", \"ns_per_op_median\": " << format("%.3f", r.medianNs) << "}";
+  }
+  os << "\n  ]\n}\n";
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  cl::SetVersionPrinter(klee::printVersion);
+  cl::HideUnrelatedOptions(BenchCat);
+  cl::ParseCommandLineOptions(argc, argv, "KLEE micro-benchmarks\n");
+
+  llvm::InitializeNativeTarget();
+
+  // The executor initializes the context from the module's data layout
+  InterpreterBench interpreter;
+  bool runInterpreter =
+      !SkipInterpreter &&
+      StringRef("executor/execute-instruction").contains(Filter) &&
+      interpreter.setUp();
+  if (!runInterpreter)
+    Context::initialize(/*IsLittleEndian=*/true, Expr::Int64);
+
+  Corpus corpus;
+  if (KQueryFile.empty())
+    corpus.synthesize(2000);
+  else
+    corpus.load(KQueryFile);
+
+  std::vector<Benchmark> benchmarks;
+  addExprBenchmarks(benchmarks, corpus);
+  ArrayCache memoryArrays;
+  MemoryManager memory(&memoryArrays);
+  addMemoryBenchmarks(benchmarks, memory);
+  if (runInterpreter)
+    addInterpreterBenchmarks(benchmarks, interpreter);
+
+  std::vector<Result> results;
+  llvm::outs() << "benchmark                          operations"
+                  "      min ns/op   median ns/op\n";
+  for (const Benchmark &b : benchmarks) {
+    if (!StringRef(b.name).contains(Filter))
+      continue;
+    results.push_back(measure(b));
+    const Result &r = results.back();
+    llvm::outs() << format("%-32s %12lu %14.2f %14.2f\n", r.name.c_str(),
+                           (unsigned long)r.operations, r.minNs, r.medianNs);
+    llvm::outs().flush();
+  }
+
+  if (!JSONFile.empty())
+    writeJSON(JSONFile, results, corpus.exprs.size());
+  return 0;
+}
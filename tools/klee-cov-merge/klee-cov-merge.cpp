@@ -0,0 +1,122 @@
+//===-- klee-cov-merge.cpp --------------------------------------*- C++ -*-===//
+//
+//                     The KLEE Symbolic Virtual Machine
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// Merges the edge coverage maps (.covmap files) written with --write-cov-map
+// into a single map, e.g. to track the coverage of a whole campaign.
+//
+//===----------------------------------------------------------------------===//
+
+#include "klee/Support/CoverageMap.h"
+#include "klee/Support/PrintVersion.h"
+
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace klee;
+
+namespace {
+llvm::cl::list<std::string>
+    Inputs(llvm::cl::Positional, llvm::cl::OneOrMore,
+           llvm::cl::desc("<.covmap files or directories containing them>"));
+
+llvm::cl::opt<std::string>
+    Output("o", llvm::cl::value_desc("file"),
+           llvm::cl::desc("Write the merged map to this file, which is also "
+                          "merged if it exists"));
+
+llvm::cl::opt<bool>
+    PrintNew("print-new",
+             llvm::cl::desc("Print the inputs adding new edges to the merged "
+                            "map, and how many (default=false)"));
+
+void collectInputs(const std::string &path, std::vector<std::string> &files) {
+  if (!llvm::sys::fs::is_directory(path)) {
+    files.push_back(path);
+    return;
+  }
+  std::vector<std::string> found;
+  std::error_code ec;
+  for (llvm::sys::fs::directory_iterator it(path, ec), ie; it != ie && !ec;
+       it.increment(ec)) {
+    if (llvm::StringRef(it->path()).endswith(".covmap"))
+      found.push_back(it->path());
+  }
+  if (ec) {
+    llvm::errs() << "klee-cov-merge: " << path << ": " << ec.message()
+                 << '\n';
+    exit(1);
+  }
+  // Deterministic order, so that --print-new blames the first test
+  std::sort(found.begin(), found.end());
+  files.insert(files.end(), found.begin(), found.end());
+}
+
+void readMap(const std::string &path, CoverageMap &map) {
+  std::string error;
+  if (!map.read(path, error)) {
+    llvm::errs() << "klee-cov-merge: " << path << ": " << error << '\n';
+    exit(1);
+  }
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  llvm::cl::SetVersionPrinter(klee::printVersion);
+  llvm::cl::ParseCommandLineOptions(argc, argv, " klee-cov-merge\n");
+
+  std::vector<std::string> files;
+  for (const auto &input : Inputs)
+    collectInputs(input, files);
+
+  CoverageMap merged;
+  bool haveMerged = false;
+  if (!Output.empty() && llvm::sys::fs::exists(Output)) {
+    readMap(Output, merged);
+    haveMerged = true;
+  }
+
+  for (const auto &file : files) {
+    CoverageMap map;
+    readMap(file, map);
+    if (!haveMerged) {
+      merged = CoverageMap(map.size());
+      haveMerged = true;
+    }
+    if (map.size() != merged.size()) {
+      llvm::errs() << "klee-cov-merge: " << file
+                   << ": map size differs from the other inputs\n";
+      return 1;
+    }
+    std::size_t added = merged.merge(map);
+    if (PrintNew && added)
+      llvm::outs() << file << ": " << added << " new\n";
+  }
+
+  if (!haveMerged) {
+    llvm::errs() << "klee-cov-merge: no coverage maps found\n";
+    return 1;
+  }
+
+  llvm::outs() << "Edges: " << merged.count() << '\n';
+
+  if (!Output.empty()) {
+    std::string error;
+    if (!merged.write(Output, error)) {
+      llvm::errs() << "klee-cov-merge: " << Output << ": " << error << '\n';
+      return 1;
+    }
+  }
+  return 0;
+}
@@ -17,8 +17,10 @@
 #include "klee/Support/OptionCategories.h"
 #include "klee/Statistics/Statistics.h"
 #include "klee/Solver/SolverCmdLine.h"
+#include "klee/Support/CoverageMap.h"
 #include "klee/Support/Debug.h"
 #include "klee/Support/ErrorHandling.h"
+#include "klee/Support/EventLog.h"
 #include "klee/Support/FileHandling.h"
 #include "klee/Support/ModuleUtil.h"
 #include "klee/Support/PrintVersion.h"
@@ -102,6 +104,27 @@ namespace {
            cl::desc("Write coverage information for each test case (default=false)"),
            cl::cat(TestCaseCat));
 
+  cl::opt<bool>
+  WriteCovMap("write-cov-map",
+              cl::desc("Write a bitmap of the control flow edges covered by "
+                       "each test case to .covmap files, see klee-cov-merge "
+                       "(default=false)"),
+              cl::cat(TestCaseCat));
+
+  cl::opt<unsigned>
+  CovMapSize("cov-map-size",
+             cl::desc("Size of the edge coverage bitmaps in bytes, a power "
+                      "of two (default=65536)"),
+             cl::init(65536),
+             cl::cat(TestCaseCat));
+
+  cl::opt<bool>
+  CovMapContext("cov-map-context",
+                cl::desc("Distinguish edges in the coverage bitmaps by their "
+                         "calling context, requires --output-istats and "
+                         "--use-call-paths (default=false)"),
+                cl::cat(TestCaseCat));
+
   cl::opt<bool>
   WriteTestInfo("write-test-info",
                 cl::desc("Write additional test case information (default=false)"),
@@ -117,6 +140,20 @@ namespace {
                 cl::desc("Write .sym.path files for each test case (default=false)"),
                 cl::cat(TestCaseCat));
 
+  enum class EventLogType { Text, JSON, All };
+
+  cl::opt<EventLogType> EventLogFormat(
+      "event-log",
+      cl::desc("Format of the concolic event log (ppc, trace, expr, "
+               "concrete, taint and memory events)"),
+      cl::values(
+          clEnumValN(EventLogType::Text, "text",
+                     "One <kind>.log text file per event kind (default)"),
+          clEnumValN(EventLogType::JSON, "json",
+                     "All events tagged with their state id in events.jsonl"),
+          clEnumValN(EventLogType::All, "all", "Both of the above")),
+      cl::init(EventLogType::Text), cl::cat(TestCaseCat));
+
 
   /*** Startup options ***/
 
@@ -406,35 +443,12 @@ KleeHandler::KleeHandler(int argc, char **argv)
   if ((klee_message_file = fopen(file_path.c_str(), "w")) == NULL)
     klee_error("cannot open file \"%s\": %s", file_path.c_str(), strerror(errno));
 
-  // open ppc.log
-  file_path = getOutputFilename("ppc.log");
-  if ((klee_ppc_file = fopen(file_path.c_str(), "w")) == NULL)
-    klee_error("cannot open file \"%s\": %s", file_path.c_str(), strerror(errno));
-
-  // open concrete.log
-  file_path = getOutputFilename("concrete.log");
-  if ((klee_concrete_file = fopen(file_path.c_str(), "w")) == NULL)
-      klee_error("cannot open file \"%s\": %s", file_path.c_str(), strerror(errno));
-
-  // open expr.log
-  file_path = getOutputFilename("expr.log");
-  if ((klee_expr_file = fopen(file_path.c_str(), "w")) == NULL)
-    klee_error("cannot open file \"%s\": %s", file_path.c_str(), strerror(errno));
-
-  // open trace.log
-  file_path = getOutputFilename("trace.log");
-  if ((klee_trace_file = fopen(file_path.c_str(), "w")) == NULL)
-    klee_error("cannot open file \"%s\": %s", file_path.c_str(), strerror(errno));
-
-  // open taint.log
-  file_path = getOutputFilename("taint.log");
-  if ((klee_taint_file = fopen(file_path.c_str(), "w")) == NULL)
-    klee_error("cannot open file \"%s\": %s", file_path.c_str(), strerror(errno));
-
-  // open memory.log
-  file_path = getOutputFilename("memory.log");
-  if ((klee_memory_file = fopen(file_path.c_str(), "w")) == NULL)
-    klee_error("cannot open file \"%s\": %s", file_path.c_str(), strerror(errno));
+  // start the event log (ppc.log, trace.log, ...), written asynchronously
+  if (EventLogFormat != EventLogType::JSON)
+    EventLog::addSink(createTextEventSink(m_outputDirectory.str().str()));
+  if (EventLogFormat != EventLogType::Text)
+    EventLog::addSink(createJSONEventSink(getOutputFilename("events.jsonl")));
+  EventLog::start();
 
   // open info
   m_infoFile = openOutputFile("info");
@@ -444,13 +458,8 @@ KleeHandler::~KleeHandler() {
   delete m_pathWriter;
   delete m_symPathWriter;
   fclose(klee_warning_file);
+  EventLog::stop();
   fclose(klee_message_file);
-  fclose(klee_ppc_file);
-  fclose(klee_expr_file);
-  fclose(klee_trace_file);
-  fclose(klee_taint_file);
-  fclose(klee_memory_file);
-  fclose(klee_concrete_file);
 }
 
 void KleeHandler::setInterpreter(Interpreter *i) {
@@ -615,6 +624,13 @@ void KleeHandler::processTestCase(const ExecutionState &state,
       }
     }
 
+    if (const CoverageMap *covMap = m_interpreter->getEdgeCoverage(state)) {
+      std::string error;
+      if (!covMap->write(getOutputFilename(getTestFilename("covmap", id)),
+                         error))
+        klee_warning("unable to write coverage map file: %s", error.c_str());
+    }
+
     if (m_numGeneratedTests == MaxTests)
       m_interpreter->setHaltExecution(true);
 
@@ -1020,6 +1036,12 @@ static void interrupt_handle() {
   interrupted = true;
 }
 
+// Write out the events still buffered for ppc.log and the other logs before
+// a crash signal kills KLEE
+static void flush_event_log(void *) {
+  EventLog::flush();
+}
+
 static void interrupt_handle_watchdog() {
   // just wait for the child to finish
 }
@@ -1166,6 +1188,7 @@ int main(int argc, char **argv, char **envp) {
 
   parseArguments(argc, argv);
   sys::PrintStackTraceOnErrorSignal(argv[0]);
+  sys::AddSignalHandler(flush_event_log, nullptr);
 
   if (EntryPoint.empty()) {
     klee_error("entry-point cannot be empty");
@@ -1408,6 +1431,12 @@ int main(int argc, char **argv, char **envp) {
 
   Interpreter::InterpreterOptions IOpts;
   IOpts.MakeConcreteSymbolic = MakeConcreteSymbolic;
+  if (WriteCovMap) {
+    if (!CovMapSize || (CovMapSize & (CovMapSize - 1)))
+      klee_error("--cov-map-size must be a power of two");
+    IOpts.CoverageMapSize = CovMapSize;
+    IOpts.CoverageMapContext = CovMapContext;
+  }
   KleeHandler *handler = new KleeHandler(pArgc, pArgv);
   Interpreter *interpreter =
     theInterpreter = Interpreter::create(ctx, IOpts, handler);
@@ -1535,6 +1564,19 @@ int main(int argc, char **argv, char **envp) {
     }
     interpreter->runFunctionAsMain(mainFn, pArgc, pArgv, pEnvp);
 
+    // Follow the seeds derived by a --concolic-runs campaign
+    while (!seeds.empty() && !interrupted) {
+      KTest *next = interpreter->getNextConcolicSeed();
+      if (!next)
+        break;
+      while (!seeds.empty()) {
+        kTest_free(seeds.back());
+        seeds.pop_back();
+      }
+      seeds.push_back(next);
+      interpreter->runFunctionAsMain(mainFn, pArgc, pArgv, pEnvp);
+    }
+
     while (!seeds.empty()) {
       kTest_free(seeds.back());
       seeds.pop_back();
@@ -0,0 +1,86 @@
+#include "klee/ADT/BitArray.h"
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+using namespace klee;
+
+namespace {
+
+TEST(BitArrayTest, RangeSetUnset) {
+  const unsigned size = 200;
+  BitArray ba(size);
+
+  ba.setRange(3, 131);
+  for (unsigned i = 0; i < size; ++i)
+    ASSERT_EQ(i >= 3 && i < 131, ba.get(i)) << "bit " << i;
+
+  ba.unsetRange(60, 70);
+  for (unsigned i = 0; i < size; ++i)
+    ASSERT_EQ((i >= 3 && i < 60) || (i >= 70 && i < 131), ba.get(i))
+        << "bit " << i;
+
+  // Empty ranges are no-ops.
+  ba.setRange(10, 10);
+  ba.unsetRange(150, 150);
+  ASSERT_EQ(118u, ba.count(0, size));
+}
+
+TEST(BitArrayTest, RangeQueries) {
+  const unsigned size = 300;
+  BitArray ba(size, true);
+
+  ASSERT_TRUE(ba.allSet(0, size));
+  ASSERT_FALSE(ba.noneSet(0, size));
+  ASSERT_EQ(size, ba.findFirstUnset(0, size));
+  ASSERT_EQ(0u, ba.findFirstSet(0, size));
+
+  ba.unset(64);
+  ba.unset(255);
+  ASSERT_FALSE(ba.allSet(0, size));
+  ASSERT_TRUE(ba.allSet(0, 64));
+  ASSERT_TRUE(ba.allSet(65, 255));
+  ASSERT_EQ(64u, ba.findFirstUnset(0, size));
+  ASSERT_EQ(255u, ba.findFirstUnset(65, size));
+  ASSERT_EQ(size, ba.findFirstUnset(256, size));
+  ASSERT_EQ(size - 2, ba.count(0, size));
+
+  ba.unsetRange(0, size);
+  ASSERT_TRUE(ba.noneSet(0, size));
+  ASSERT_EQ(size, ba.findFirstSet(0, size));
+  ba.set(299);
+  ASSERT_EQ(299u, ba.findFirstSet(0, size));
+  ASSERT_EQ(250u, ba.findFirstSet(250, 250));
+}
+
+TEST(BitArrayTest, MatchesPerBitReference) {
+  const unsigned size = 157;
+  BitArray ba(size);
+  std::vector<bool> ref(size);
+  for (unsigned i = 0; i < size; ++i) {
+    bool v = (i * 7919u) % 5 < 2;
+    ba.set(i, v);
+    ref[i] = v;
+  }
+
+  for (unsigned b = 0; b < size; b += 13) {
+    for (unsigned e = b; e <= size; e += 11) {
+      unsigned n = 0, firstSet = e, firstUnset = e;
+      for (unsigned i = b; i < e; ++i) {
+        n += ref[i];
+        if (ref[i] && firstSet == e)
+          firstSet = i;
+        if (!ref[i] && firstUnset == e)
+          firstUnset = i;
+      }
+      ASSERT_EQ(n, ba.count(b, e));
+      ASSERT_EQ(n == e - b, ba.allSet(b, e));
+      ASSERT_EQ(n == 0, ba.noneSet(b, e));
+      ASSERT_EQ(firstSet, ba.findFirstSet(b, e));
+      ASSERT_EQ(firstUnset, ba.findFirstUnset(b, e));
+    }
+  }
+}
+
+} // namespace
@@ -0,0 +1,57 @@
+#include "klee/Support/CoverageMap.h"
+
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <unistd.h>
+
+using namespace klee;
+
+TEST(CoverageMapTest, Merge) {
+  CoverageMap a(64), b(64);
+  EXPECT_EQ(0u, a.count());
+
+  a.addEdge(1, 2);
+  a.addEdge(1, 2);
+  EXPECT_EQ(1u, a.count());
+
+  b.addEdge(1, 2);
+  b.addEdge(2, 3);
+  EXPECT_EQ(2u, b.count());
+
+  // Only the edge missing from a is new
+  EXPECT_EQ(1u, a.merge(b));
+  EXPECT_EQ(2u, a.count());
+  EXPECT_EQ(0u, a.merge(b));
+  EXPECT_EQ(a, b);
+}
+
+TEST(CoverageMapTest, Context) {
+  EXPECT_NE(CoverageMap::hashEdge(1, 2, 0), CoverageMap::hashEdge(2, 1, 0));
+  EXPECT_NE(CoverageMap::hashEdge(1, 2, 0), CoverageMap::hashEdge(1, 2, 7));
+}
+
+TEST(CoverageMapTest, ReadWrite) {
+  char path[] = "/tmp/klee-covmap-XXXXXX";
+  int fd = mkstemp(path);
+  ASSERT_NE(-1, fd);
+  close(fd);
+
+  CoverageMap map(128);
+  for (unsigned i = 0; i < 10; ++i)
+    map.addEdge(i, i + 1);
+  std::string error;
+  ASSERT_TRUE(map.write(path, error)) << error;
+
+  CoverageMap read;
+  ASSERT_TRUE(read.read(path, error)) << error;
+  EXPECT_EQ(128u, read.size());
+  EXPECT_EQ(map, read);
+
+  // Truncated files are rejected
+  ASSERT_EQ(0, truncate(path, 20));
+  EXPECT_FALSE(read.read(path, error));
+  unlink(path);
+}
@@ -0,0 +1,105 @@
+#include "klee/Support/DependencyIndex.h"
+
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <unistd.h>
+
+using namespace klee;
+
+TEST(DependencyIndexTest, Ranges) {
+  DependencyIndex index;
+  std::uint32_t x = index.getObject("x", 4);
+  std::uint32_t y = index.getObject("y", 8);
+  EXPECT_EQ(x, index.getObject("x", 6));
+  std::vector<std::uint32_t> sizes = {6, 8};
+  EXPECT_EQ(sizes, index.getObjectSizes());
+
+  DependencyIndex::Site &site = index.getSite(10, "a.c", 3);
+  site.bytes[x] = {0, 1, 2, 5};
+  site.bytes[y] = {7};
+  std::vector<DependencyIndex::Range> expected = {
+      {x, 0, 3}, {x, 5, 6}, {y, 7, 8}};
+  EXPECT_EQ(expected, site.getRanges());
+
+  // The location of a site is kept
+  EXPECT_EQ(&site, &index.getSite(10, "b.c", 4));
+  EXPECT_EQ("a.c", site.file);
+}
+
+TEST(DependencyIndexTest, ReadWrite) {
+  char path[] = "/tmp/klee-deps-XXXXXX";
+  int fd = mkstemp(path);
+  ASSERT_NE(-1, fd);
+  close(fd);
+
+  DependencyIndex index;
+  std::uint32_t x = index.getObject("x", 8);
+  std::uint32_t y = index.getObject("y", 5);
+  index.getSite(10, "a.c", 3).bytes[x] = {0, 1, 2, 5};
+  index.getSite(20, "b.c", 9).bytes[y] = {4};
+  index.getSite(20, "b.c", 9).bytes[x] = {7};
+  std::string error;
+  ASSERT_TRUE(index.write(path, error)) << error;
+
+  DependencyIndex read;
+  ASSERT_TRUE(read.read(path, error)) << error;
+  EXPECT_EQ(index.getObjects(), read.getObjects());
+  EXPECT_EQ(index.getObjectSizes(), read.getObjectSizes());
+  ASSERT_EQ(2u, read.getSites().size());
+  for (const auto &site : index.getSites()) {
+    const DependencyIndex::Site &other = read.getSites().at(site.first);
+    EXPECT_EQ(site.second.file, other.file);
+    EXPECT_EQ(site.second.line, other.line);
+    EXPECT_EQ(site.second.bytes, other.bytes);
+  }
+
+  // Truncated files are rejected
+  ASSERT_EQ(0, truncate(path, 30));
+  EXPECT_FALSE(read.read(path, error));
+  EXPECT_EQ("truncated dependency index", error);
+  unlink(path);
+}
+
+/* A range beyond its object, or one overlapping the previous range, is
+   rejected rather than read byte by byte. */
+TEST(DependencyIndexTest, InvalidRanges) {
+  char path[] = "/tmp/klee-deps-XXXXXX";
+  int fd = mkstemp(path);
+  ASSERT_NE(-1, fd);
+  close(fd);
+
+  DependencyIndex index;
+  std::uint32_t x = index.getObject("x", 4);
+  index.getSite(10, "a.c", 3).bytes[x] = {1, 3};
+  std::string error;
+  ASSERT_TRUE(index.write(path, error)) << error;
+
+  // The file ends with the ranges [1, 2) and [3, 4) of x, patch the bounds
+  // of the second one
+  auto patch = [&](std::uint32_t begin, std::uint32_t end) {
+    FILE *f = fopen(path, "r+b");
+    ASSERT_NE(nullptr, f);
+    std::uint8_t bytes[8];
+    for (unsigned i = 0; i < 4; ++i) {
+      bytes[i] = begin >> (8 * i);
+      bytes[4 + i] = end >> (8 * i);
+    }
+    ASSERT_EQ(0, fseek(f, -8, SEEK_END));
+    ASSERT_EQ(8u, fwrite(bytes, 1, 8, f));
+    fclose(f);
+  };
+
+  DependencyIndex read;
+  patch(3, 0xffffffff);
+  EXPECT_FALSE(read.read(path, error));
+  EXPECT_EQ("invalid dependency index range", error);
+  patch(1, 2);
+  EXPECT_FALSE(read.read(path, error));
+  EXPECT_EQ("invalid dependency index range", error);
+  patch(2, 4);
+  EXPECT_TRUE(read.read(path, error)) << error;
+  unlink(path);
+}
@@ -0,0 +1,151 @@
+#include "klee/Support/EventLog.h"
+
+#include "gtest/gtest.h"
+
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/FileSystem.h"
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace klee;
+
+namespace {
+/// Sink keeping the events in memory, shared with the test
+class CollectingSink : public EventSink {
+  std::shared_ptr<std::vector<Event>> events;
+  std::shared_ptr<bool> flushed;
+
+public:
+  CollectingSink(std::shared_ptr<std::vector<Event>> events,
+                 std::shared_ptr<bool> flushed)
+      : events(events), flushed(flushed) {}
+
+  void write(const std::vector<Event> &batch) override {
+    events->insert(events->end(), batch.begin(), batch.end());
+  }
+
+  void flush() override { *flushed = true; }
+};
+
+/// Fixture providing a temporary directory for the log files
+class EventLogFileTest : public ::testing::Test {
+protected:
+  std::string directory;
+
+  void SetUp() override {
+    llvm::SmallString<128> path;
+    ASSERT_FALSE(llvm::sys::fs::createUniqueDirectory("klee-eventlog", path));
+    directory = path.str().str();
+  }
+
+  void TearDown() override {
+    if (!directory.empty())
+      llvm::sys::fs::remove_directories(directory);
+  }
+};
+} // namespace
+
+/* Events logged before the log is started or after it is stopped are
+   dropped, everything in between reaches the sink in order. */
+TEST(EventLogTest, DeliversInOrder) {
+  auto events = std::make_shared<std::vector<Event>>();
+  auto flushed = std::make_shared<bool>(false);
+
+  EventLog::log(EventKind::PPC, 1, "dropped");
+  EventLog::addSink(std::make_unique<CollectingSink>(events, flushed));
+  EventLog::start();
+  // More than fits into a ring buffer, so the producer has to wait
+  const unsigned count = 100000;
+  for (unsigned i = 0; i < count; ++i)
+    EventLog::log(EventKind::Trace, i % 7, std::to_string(i));
+  EventLog::stop();
+  EventLog::log(EventKind::PPC, 1, "dropped");
+
+  ASSERT_TRUE(*flushed);
+  ASSERT_EQ(count, events->size());
+  for (unsigned i = 0; i < count; ++i) {
+    EXPECT_EQ(EventKind::Trace, (*events)[i].kind);
+    EXPECT_EQ(i % 7, (*events)[i].stateID);
+    EXPECT_EQ(std::to_string(i), (*events)[i].text);
+  }
+}
+
+/* Every thread logs into its own ring, the order is kept per thread. */
+TEST(EventLogTest, MultipleThreads) {
+  auto events = std::make_shared<std::vector<Event>>();
+  auto flushed = std::make_shared<bool>(false);
+  EventLog::addSink(std::make_unique<CollectingSink>(events, flushed));
+  EventLog::start();
+
+  const unsigned threads = 4, count = 20000;
+  std::vector<std::thread> producers;
+  for (unsigned t = 0; t < threads; ++t)
+    producers.emplace_back([t] {
+      for (unsigned i = 0; i < count; ++i)
+        EventLog::log(EventKind::Memory, t, std::to_string(i));
+    });
+  for (auto &producer : producers)
+    producer.join();
+  EventLog::stop();
+
+  ASSERT_EQ(threads * count, events->size());
+  std::vector<unsigned> next(threads, 0);
+  for (const auto &event : *events) {
+    ASSERT_LT(event.stateID, threads);
+    EXPECT_EQ(std::to_string(next[event.stateID]++), event.text);
+  }
+}
+
+/* The text sink writes the same lines as the former klee_log_* functions. */
+TEST_F(EventLogFileTest, TextSink) {
+  EventLog::addSink(createTextEventSink(directory));
+  EventLog::addSink(createJSONEventSink(directory + "/events.jsonl"));
+  EventLog::start();
+  EventLog::log(EventKind::PPC, 3, "\n[path:ppc] a.c:1 : (x)");
+  EventLog::log(EventKind::Taint, 4, "t");
+  EventLog::stop();
+
+  std::ifstream ppc(directory + "/ppc.log");
+  std::string content((std::istreambuf_iterator<char>(ppc)),
+                      std::istreambuf_iterator<char>());
+  EXPECT_EQ("KLEE: PartialPathCondition: \n[path:ppc] a.c:1 : (x)\n", content);
+
+  std::ifstream json(directory + "/events.jsonl");
+  std::string line;
+  ASSERT_TRUE(std::getline(json, line));
+  EXPECT_EQ("{\"kind\":\"ppc\",\"state\":3,"
+            "\"text\":\"\\n[path:ppc] a.c:1 : (x)\"}",
+            line);
+  ASSERT_TRUE(std::getline(json, line));
+  EXPECT_EQ("{\"kind\":\"taint\",\"state\":4,\"text\":\"t\"}", line);
+}
+
+/* flush() writes out everything logged so far while the log keeps running,
+   as KLEE does before it exits on an error or a crash signal. */
+TEST_F(EventLogFileTest, FlushWithoutStopping) {
+  EventLog::addSink(createTextEventSink(directory));
+  EventLog::start();
+  const unsigned count = 1000;
+  std::string expected;
+  for (unsigned i = 0; i < count; ++i) {
+    EventLog::log(EventKind::PPC, 1, std::to_string(i));
+    expected += "KLEE: PartialPathCondition: " + std::to_string(i) + "\n";
+  }
+  EventLog::flush();
+
+  std::ifstream ppc(directory + "/ppc.log");
+  std::string content((std::istreambuf_iterator<char>(ppc)),
+                      std::istreambuf_iterator<char>());
+  EXPECT_EQ(expected, content);
+
+  EventLog::log(EventKind::PPC, 1, "after");
+  EventLog::stop();
+  std::ifstream all(directory + "/ppc.log");
+  content.assign(std::istreambuf_iterator<char>(all),
+                 std::istreambuf_iterator<char>());
+  EXPECT_EQ(expected + "KLEE: PartialPathCondition: after\n", content);
+}
@@ -0,0 +1,142 @@
+//===-- ConstraintsTest.cpp -----------------------------------------------===//
+//
+//                     The KLEE Symbolic Virtual Machine
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "klee/Expr/ArrayCache.h"
+#include "klee/Expr/Constraints.h"
+#include "klee/Expr/Expr.h"
+
+#include <vector>
+
+using namespace klee;
+
+namespace {
+
+ref<Expr> c32(uint64_t value) { return ConstantExpr::create(value, Expr::Int32); }
+
+std::vector<ref<Expr>> toVector(const ConstraintSet &cs) {
+  return std::vector<ref<Expr>>(cs.begin(), cs.end());
+}
+
+TEST(ConstraintsTest, CompactMergesRanges) {
+  ArrayCache ac;
+  const Array *array = ac.CreateArray("arr", 8);
+  ref<Expr> x = Expr::createTempRead(array, Expr::Int32);
+  ref<Expr> y = Expr::createTempRead(ac.CreateArray("arr2", 4), Expr::Int32);
+
+  ConstraintSet cs;
+  ConstraintManager cm(cs);
+  cm.addConstraint(UltExpr::create(x, c32(100)));
+  cm.addConstraint(UltExpr::create(c32(3), y));
+  cm.addConstraint(UleExpr::create(c32(10), x));
+  cm.addConstraint(UltExpr::create(x, c32(50)));
+  cm.addConstraint(Expr::createIsZero(UltExpr::create(x, c32(20))));
+  cm.compact();
+
+  // The merged range takes the place of the last constraint on x
+  std::vector<ref<Expr>> expected = {UltExpr::create(c32(3), y),
+                                     UleExpr::create(c32(20), x),
+                                     UleExpr::create(x, c32(49))};
+  EXPECT_EQ(expected, toVector(cs));
+}
+
+TEST(ConstraintsTest, CompactResumesFromLastCompaction) {
+  ArrayCache ac;
+  ref<Expr> x = Expr::createTempRead(ac.CreateArray("arr", 4), Expr::Int32);
+  ref<Expr> y = Expr::createTempRead(ac.CreateArray("arr2", 4), Expr::Int32);
+  ref<Expr> p = EqExpr::create(x, y);
+
+  ConstraintSet cs;
+  ConstraintManager cm(cs);
+  cm.addConstraint(UltExpr::create(x, c32(100)));
+  cm.addConstraint(p);
+  cm.compact();
+
+  // A copy compacts on its own
+  ConstraintSet copy = cs;
+  ConstraintManager copyManager(copy);
+  copyManager.addConstraint(UltExpr::create(x, c32(7)));
+  copyManager.compact();
+
+  cm.addConstraint(UltExpr::create(c32(3), y));
+  cm.addConstraint(p);
+  cm.addConstraint(UleExpr::create(c32(10), x));
+  cm.compact();
+
+  std::vector<ref<Expr>> expected = {p, UltExpr::create(c32(3), y),
+                                     UleExpr::create(c32(10), x),
+                                     UleExpr::create(x, c32(99))};
+  EXPECT_EQ(expected, toVector(cs));
+
+  expected = {p, UleExpr::create(x, c32(6))};
+  EXPECT_EQ(expected, toVector(copy));
+
+  // Disjunctions are checked against the ranges of earlier compactions
+  cm.addConstraint(
+      OrExpr::create(UltExpr::create(y, c32(5)), UltExpr::create(x, c32(200))));
+  cm.compact();
+  EXPECT_EQ(4u, cs.size());
+}
+
+TEST(ConstraintsTest, CompactPinsSingletonRange) {
+  ArrayCache ac;
+  ref<Expr> x = Expr::createTempRead(ac.CreateArray("arr", 4), Expr::Int32);
+
+  ConstraintSet cs;
+  ConstraintManager cm(cs);
+  cm.addConstraint(SleExpr::create(c32(7), x));
+  cm.addConstraint(SltExpr::create(x, c32(8)));
+  cm.compact();
+
+  std::vector<ref<Expr>> expected = {EqExpr::create(c32(7), x)};
+  EXPECT_EQ(expected, toVector(cs));
+}
+
+TEST(ConstraintsTest, CompactDropsImpliedDisjunctions) {
+  ArrayCache ac;
+  ref<Expr> x = Expr::createTempRead(ac.CreateArray("arr", 4), Expr::Int32);
+  ref<Expr> y = Expr::createTempRead(ac.CreateArray("arr2", 4), Expr::Int32);
+  ref<Expr> p = EqExpr::create(x, y);
+
+  ConstraintSet cs;
+  ConstraintManager cm(cs);
+  cm.addConstraint(UltExpr::create(x, c32(10)));
+  cm.addConstraint(p);
+  // Implied by p
+  cm.addConstraint(OrExpr::create(UltExpr::create(y, c32(5)), p));
+  // Implied by x < 10
+  cm.addConstraint(
+      OrExpr::create(UltExpr::create(y, c32(5)), UltExpr::create(x, c32(20))));
+  // Not implied
+  ref<Expr> q =
+      OrExpr::create(UltExpr::create(y, c32(5)), UltExpr::create(x, c32(3)));
+  cm.addConstraint(q);
+  cm.compact();
+
+  std::vector<ref<Expr>> expected = {UltExpr::create(x, c32(10)), p, q};
+  EXPECT_EQ(expected, toVector(cs));
+}
+
+TEST(ConstraintsTest, CompactKeepsContradictions) {
+  ArrayCache ac;
+  ref<Expr> x = Expr::createTempRead(ac.CreateArray("arr", 4), Expr::Int32);
+
+  ConstraintSet cs;
+  ConstraintManager cm(cs);
+  cm.addConstraint(UltExpr::create(x, c32(10)));
+  cm.addConstraint(UltExpr::create(c32(20), x));
+  cm.addConstraint(UltExpr::create(x, c32(10)));
+  cm.compact();
+
+  std::vector<ref<Expr>> expected = {UltExpr::create(x, c32(10)),
+                                     UltExpr::create(c32(20), x)};
+  EXPECT_EQ(expected, toVector(cs));
+}
+} // namespace
@@ -8,10 +8,15 @@
 //===----------------------------------------------------------------------===//
 
 #include <iostream>
+#include <memory>
+#include <vector>
 #include "gtest/gtest.h"
 
 #include "klee/Expr/ArrayCache.h"
 #include "klee/Expr/Expr.h"
+#include "klee/Expr/ExprUtil.h"
+
+#include "llvm/ADT/APFloat.h"
 
 using namespace klee;
 
@@ -264,4 +269,167 @@ TEST(ExprTest, ReadExprFoldingSymbolicIndexUpdate) {
     EXPECT_EQ(Expr::Read, read.get()->getKind());
   }
 }
+
+TEST(ExprTest, FloatingPointConstantFolding) {
+  auto d = [](double v) -> ref<Expr> {
+    return ConstantExpr::alloc(llvm::APFloat(v).bitcastToAPInt());
+  };
+  auto f = [](float v) -> ref<Expr> {
+    return ConstantExpr::alloc(llvm::APFloat(v).bitcastToAPInt());
+  };
+
+  // Arithmetic folds to the IEEE-754 bit pattern of the result
+  EXPECT_EQ(d(3.5), FAddExpr::create(d(1.25), d(2.25)));
+  EXPECT_EQ(d(-1.0), FSubExpr::create(d(1.25), d(2.25)));
+  EXPECT_EQ(d(2.5), FMulExpr::create(d(1.25), d(2.0)));
+  EXPECT_EQ(f(0.5f), FDivExpr::create(f(1.0f), f(2.0f)));
+
+  // Ordered comparisons are false on NaN
+  ref<Expr> nan = ConstantExpr::alloc(
+      llvm::APFloat::getNaN(llvm::APFloat::IEEEdouble()).bitcastToAPInt());
+  EXPECT_TRUE(FOLtExpr::create(d(1.0), d(2.0))->isTrue());
+  EXPECT_TRUE(FOLeExpr::create(d(2.0), d(2.0))->isTrue());
+  EXPECT_TRUE(FOEqExpr::create(nan, nan)->isFalse());
+  EXPECT_TRUE(FOLeExpr::create(nan, d(2.0))->isFalse());
+
+  // Conversions
+  EXPECT_EQ(f(1.5f), FPConvertExpr::create(d(1.5), Expr::Int32));
+  EXPECT_EQ(getConstant(-2, Expr::Int32),
+            FPToSIExpr::create(d(-2.75), Expr::Int32));
+  EXPECT_EQ(getConstant(7, Expr::Int8), FPToUIExpr::create(f(7.9f), Expr::Int8));
+  EXPECT_EQ(d(-3.0), SIToFPExpr::create(getConstant(-3, Expr::Int32),
+                                        Expr::Int64));
+  EXPECT_EQ(f(253.0f), UIToFPExpr::create(getConstant(-3, Expr::Int8),
+                                          Expr::Int32));
+}
+
+TEST(ExprTest, FloatingPointSymbolic) {
+  ArrayCache ac;
+  const Array *array = ac.CreateArray("arr", 8);
+  ref<Expr> x = Expr::createTempRead(array, Expr::Int64);
+  ref<Expr> one = ConstantExpr::alloc(llvm::APFloat(1.0).bitcastToAPInt());
+
+  ref<Expr> sum = FAddExpr::create(x, one);
+  EXPECT_EQ(Expr::FAdd, sum->getKind());
+  EXPECT_EQ(64u, sum->getWidth());
+
+  ref<Expr> cmp = FOLtExpr::create(x, one);
+  EXPECT_EQ(Expr::FOLt, cmp->getKind());
+  EXPECT_EQ(1u, cmp->getWidth());
+
+  EXPECT_EQ(x, FPConvertExpr::create(x, Expr::Int64));
+  ref<Expr> narrowed = FPConvertExpr::create(x, Expr::Int32);
+  EXPECT_EQ(Expr::FPConvert, narrowed->getKind());
+  EXPECT_EQ(32u, narrowed->getWidth());
+}
+
+TEST(ExprTest, InternedConstantArrays) {
+  ArrayCache ac;
+  std::vector<ref<ConstantExpr>> table, other;
+  for (unsigned i = 0; i < 16; ++i) {
+    table.push_back(ConstantExpr::alloc(i * 7, Expr::Int8));
+    other.push_back(ConstantExpr::alloc(i * 7 + (i == 15), Expr::Int8));
+  }
+
+  const Array *array =
+      ac.CreateConstantArray("t1", table.data(), table.data() + table.size());
+  const Array *same =
+      ac.CreateConstantArray("t2", table.data(), table.data() + table.size());
+  const Array *different =
+      ac.CreateConstantArray("t3", other.data(), other.data() + other.size());
+  EXPECT_EQ(array, same);
+  EXPECT_EQ("t1", array->name);
+  EXPECT_NE(array, different);
+  EXPECT_EQ(2u, ac.getNumConstantArrays());
+
+  {
+    UpdateList ul(array, nullptr);
+    UpdateList ul2(different, nullptr);
+    ref<Expr> read =
+        ReadExpr::create(ul, Expr::createTempRead(ac.CreateArray("i", 4),
+                                                  Expr::Int32));
+    ul2 = ul;
+    // The last update list of different is gone
+    EXPECT_EQ(1u, ac.getNumConstantArrays());
+  }
+  // The last reference to array was held by the read
+  EXPECT_EQ(0u, ac.getNumConstantArrays());
+
+  // Update lists may outlive the cache
+  std::unique_ptr<UpdateList> survivor;
+  {
+    ArrayCache scoped;
+    survivor.reset(new UpdateList(
+        scoped.CreateConstantArray("t4", table.data(),
+                                   table.data() + table.size()),
+        nullptr));
+  }
+  EXPECT_EQ(16u, survivor->root->size);
+}
+
+TEST(ExprTest, ReadBytes) {
+  ArrayCache ac;
+  const Array *x = ac.CreateArray("x", 8);
+  const Array *y = ac.CreateArray("y", 4);
+  typedef std::map<const Array *, std::set<std::uint64_t>> Bytes;
+
+  // Constant indices
+  Bytes bytes;
+  findReadBytes(EqExpr::create(Expr::createTempRead(x, 16),
+                               ConstantExpr::create(7, 16)),
+                bytes);
+  EXPECT_EQ((Bytes{{x, {0, 1}}}), bytes);
+
+  // A symbolic index may read any byte
+  bytes.clear();
+  ref<Expr> index = ZExtExpr::create(
+      ReadExpr::create(UpdateList(x, nullptr), ConstantExpr::create(2, 32)),
+      32);
+  findReadBytes(ReadExpr::create(UpdateList(y, nullptr), index), bytes);
+  EXPECT_EQ((Bytes{{x, {2}}, {y, {0, 1, 2, 3}}}), bytes);
+
+  // Reading an updated byte reads the update instead of the array
+  bytes.clear();
+  UpdateList ul(x, nullptr);
+  ul.extend(ConstantExpr::create(5, 32),
+            ReadExpr::create(UpdateList(y, nullptr),
+                             ConstantExpr::create(1, 32)));
+  findReadBytes(ReadExpr::create(ul, ConstantExpr::create(5, 32)), bytes);
+  EXPECT_EQ((Bytes{{y, {1}}}), bytes);
+  bytes.clear();
+  findReadBytes(ReadExpr::create(ul, ConstantExpr::create(4, 32)), bytes);
+  EXPECT_EQ((Bytes{{x, {4}}}), bytes);
+}
+
+TEST(ExprTest, DAGStats) {
+  ArrayCache ac;
+  const Array *x = ac.CreateArray("x", 8);
+  UpdateList ul(x, nullptr);
+  ul.extend(ConstantExpr::create(0, 32), ConstantExpr::create(1, 8));
+  ul.extend(ConstantExpr::create(1, 32), ConstantExpr::create(2, 8));
+  ref<Expr> index = ZExtExpr::create(
+      ReadExpr::create(UpdateList(x, nullptr), ConstantExpr::create(3, 32)),
+      Expr::Int32);
+  ref<Expr> a = ReadExpr::create(ul, index);
+  // a is shared by both kids of the sum
+  ref<Expr> sum = AddExpr::create(a, MulExpr::create(a, a));
+
+  ExprDAGStats stats;
+  ExprDAGStats::Shape shape = stats.add(sum);
+  EXPECT_EQ(5u, shape.depth);
+  EXPECT_DOUBLE_EQ(1 + 3 + (1 + 3 + 3), shape.treeSize);
+  EXPECT_EQ(5u, stats.getNumNodes());
+  EXPECT_EQ(2u, stats.getMaxUpdateListLength());
+  EXPECT_EQ(2u, stats.getKinds().at(Expr::Read));
+  EXPECT_EQ(1u, stats.getKinds().at(Expr::Mul));
+
+  // Adding a subexpression or the same expression again adds no node
+  EXPECT_EQ(3u, stats.add(a).depth);
+  stats.add(sum);
+  EXPECT_EQ(5u, stats.getNumNodes());
+  EXPECT_EQ(2u, stats.getNumRoots());
+  EXPECT_DOUBLE_EQ((5 + 3) / 2.0, stats.getAverageDepth());
+  EXPECT_DOUBLE_EQ((11 + 3) / 5.0, stats.getSharing());
+  EXPECT_EQ(0u, stats.add(ConstantExpr::create(1, 32)).depth);
+}
 }
@@ -0,0 +1,37 @@
+//===-- QueryTimeHistogramTest.cpp ----------------------------------------===//
+//
+//                     The KLEE Symbolic Virtual Machine
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "Core/QueryTimeHistogram.h"
+
+using namespace klee;
+
+TEST(QueryTimeHistogramTest, Quantiles) {
+  QueryTimeHistogram h;
+  EXPECT_EQ(0u, h.size());
+  EXPECT_EQ(time::Span(), h.getQuantile(0.99));
+
+  // 98 fast queries and 2 slow ones
+  for (unsigned i = 0; i < 98; ++i)
+    h.add(time::microseconds(100));
+  h.add(time::milliseconds(50));
+  h.add(time::seconds(2));
+  EXPECT_EQ(100u, h.size());
+
+  // Quantiles are rounded up to the next power of two microseconds
+  EXPECT_EQ(time::microseconds(128), h.getQuantile(0.5));
+  EXPECT_EQ(time::microseconds(128), h.getQuantile(0.9));
+  EXPECT_EQ(time::microseconds(65536), h.getQuantile(0.99));
+  EXPECT_EQ(time::microseconds(2097152), h.getQuantile(1));
+
+  h.clear();
+  EXPECT_EQ(0u, h.size());
+  EXPECT_EQ(time::Span(), h.getQuantile(0.5));
+}
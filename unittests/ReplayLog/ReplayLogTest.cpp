@@ -0,0 +1,93 @@
+#include "klee/Support/ReplayLog.h"
+#include "klee/Support/Timer.h"
+
+#include "gtest/gtest.h"
+
+#include <cstdlib>
+#include <string>
+#include <unistd.h>
+
+using namespace klee;
+
+namespace {
+std::string makeTempPath() {
+  char path[] = "/tmp/klee-replay-XXXXXX";
+  int fd = mkstemp(path);
+  EXPECT_NE(-1, fd);
+  close(fd);
+  return path;
+}
+} // namespace
+
+TEST(ReplayLogTest, RoundTrip) {
+  std::string path = makeTempPath();
+  std::string error;
+  ASSERT_TRUE(ReplayLog::startRecording(path, error)) << error;
+  EXPECT_TRUE(ReplayLog::isRecording());
+  EXPECT_EQ(5489u, ReplayLog::sync(ReplayEventKind::Seed, 5489));
+  ReplayLog::sync(ReplayEventKind::Allocation, 0x7f0012345678);
+  ReplayLog::record(ReplayEventKind::ExternalCall, 1, {1, 2, 3, 4});
+  ReplayLog::record(ReplayEventKind::ExternalMemory, 42, {9});
+  ReplayLog::stop();
+  EXPECT_FALSE(ReplayLog::isRecording());
+
+  ASSERT_TRUE(ReplayLog::startReplaying(path, error)) << error;
+  EXPECT_TRUE(ReplayLog::isReplaying());
+  // Replayed values override the ones of the new run
+  EXPECT_EQ(5489u, ReplayLog::sync(ReplayEventKind::Seed, 1));
+  EXPECT_EQ(0x7f0012345678u, ReplayLog::sync(ReplayEventKind::Allocation, 0));
+
+  std::uint64_t value;
+  EXPECT_FALSE(ReplayLog::peek(ReplayEventKind::ExternalMemory, value));
+  std::vector<std::uint8_t> data;
+  EXPECT_EQ(1u, ReplayLog::replay(ReplayEventKind::ExternalCall, &data));
+  EXPECT_EQ(std::vector<std::uint8_t>({1, 2, 3, 4}), data);
+  ASSERT_TRUE(ReplayLog::peek(ReplayEventKind::ExternalMemory, value));
+  EXPECT_EQ(42u, value);
+  EXPECT_EQ(42u, ReplayLog::replay(ReplayEventKind::ExternalMemory, &data));
+  EXPECT_EQ(std::vector<std::uint8_t>({9}), data);
+  EXPECT_FALSE(ReplayLog::peek(ReplayEventKind::Timer, value));
+  ReplayLog::stop();
+  unlink(path.c_str());
+}
+
+TEST(ReplayLogTest, RejectsOtherFiles) {
+  std::string path = makeTempPath();
+  std::string error;
+  EXPECT_FALSE(ReplayLog::startReplaying(path, error));
+  EXPECT_EQ("not a replay log", error);
+  EXPECT_FALSE(ReplayLog::isReplaying());
+  unlink(path.c_str());
+}
+
+TEST(ReplayLogTest, Timers) {
+  std::string path = makeTempPath();
+  std::string error;
+  unsigned fired = 0;
+  ASSERT_TRUE(ReplayLog::startRecording(path, error)) << error;
+  {
+    TimerGroup timers(time::Span("1us"));
+    timers.add(std::make_unique<Timer>(time::Span("1us"), [&] { ++fired; }));
+    timers.reset();
+    for (unsigned i = 0; i < 3; ++i) {
+      usleep(100);
+      timers.invoke();
+    }
+  }
+  ReplayLog::stop();
+  EXPECT_EQ(3u, fired);
+
+  // Timers fire at the recorded invocations, regardless of their interval
+  ASSERT_TRUE(ReplayLog::startReplaying(path, error)) << error;
+  fired = 0;
+  {
+    TimerGroup timers(time::Span("1h"));
+    timers.add(std::make_unique<Timer>(time::Span("1h"), [&] { ++fired; }));
+    timers.reset();
+    for (unsigned i = 0; i < 3; ++i)
+      timers.invoke();
+  }
+  EXPECT_EQ(3u, fired);
+  ReplayLog::stop();
+  unlink(path.c_str());
+}
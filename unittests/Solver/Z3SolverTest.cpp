@@ -69,3 +69,51 @@ TEST_F(Z3SolverTest, GetConstraintLog) {
   ASSERT_STRNE(Occurence, nullptr);
   free(ConstraintsString);
 }
+
+TEST_F(Z3SolverTest, ReusesTranslationsAcrossQueries) {
+  ArrayCache Cache;
+  ConstraintSet Constraints;
+  ConstraintManager cm(Constraints);
+  const ref<Expr> Index =
+      Expr::createTempRead(Cache.CreateArray("index", 4), Expr::Int32);
+  cm.addConstraint(UltExpr::create(Index, ConstantExpr::alloc(4, Expr::Int32)));
+
+  auto readsNine = [&](const std::vector<uint64_t> &Values) {
+    std::vector<ref<ConstantExpr>> Contents;
+    for (uint64_t Value : Values)
+      Contents.push_back(ConstantExpr::alloc(Value, Expr::Int8));
+    const Array *Table = Cache.CreateConstantArray(
+        "table", Contents.data(), Contents.data() + Contents.size());
+    ref<Expr> Eqn = EqExpr::create(
+        ReadExpr::create(UpdateList(Table, nullptr), Index),
+        ConstantExpr::alloc(9, Expr::Int8));
+    bool Result;
+    EXPECT_TRUE(Z3Solver_->mayBeTrue(Query(Constraints, Eqn), Result));
+    return Result;
+  };
+
+  // Each table is unused (and may be freed) once its query is done, the
+  // solver must not confuse it with a later one
+  EXPECT_FALSE(readsNine({1, 2, 3, 4}));
+  EXPECT_TRUE(readsNine({1, 2, 9, 4}));
+  EXPECT_FALSE(readsNine({1, 2, 3, 4}));
+  EXPECT_TRUE(readsNine({9, 9, 9, 9}));
+}
+
+TEST_F(Z3SolverTest, FPToIntOfWidthOne) {
+  ArrayCache Cache;
+  ConstraintSet Constraints;
+  const ref<Expr> X =
+      Expr::createTempRead(Cache.CreateArray("x", 8), Expr::Int64);
+
+  // Values of width 1 are booleans to Z3, also when they come from a float
+  for (Expr::Kind Kind : {Expr::FPToSI, Expr::FPToUI}) {
+    const ref<Expr> Bit = Kind == Expr::FPToSI ? FPToSIExpr::create(X, 1)
+                                               : FPToUIExpr::create(X, 1);
+    bool Result;
+    ASSERT_TRUE(Z3Solver_->mayBeTrue(Query(Constraints, Bit), Result));
+    EXPECT_TRUE(Result);
+    ASSERT_TRUE(Z3Solver_->mayBeFalse(Query(Constraints, Bit), Result));
+    EXPECT_TRUE(Result);
+  }
+}
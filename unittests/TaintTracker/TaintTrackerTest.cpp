@@ -0,0 +1,59 @@
+//===-- TaintTrackerTest.cpp ----------------------------------------------===//
+//
+//                     The KLEE Symbolic Virtual Machine
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "Core/TaintTracker.h"
+#include "klee/Module/InstructionInfoTable.h"
+#include "klee/Module/KInstruction.h"
+
+using namespace klee;
+
+TEST(TaintTrackerTest, InternsSets) {
+  TaintTracker tracker;
+  TaintSet a = tracker.label("x", 0);
+  TaintSet b = tracker.label("x", 1);
+  TaintSet c = tracker.label("y", 0);
+  EXPECT_NE(0u, a);
+  EXPECT_EQ(a, tracker.label("x", 0));
+  EXPECT_NE(a, b);
+
+  // The empty set is the identity, and unions are interned
+  EXPECT_EQ(a, tracker.join(a, 0));
+  EXPECT_EQ(a, tracker.join(0, a));
+  EXPECT_EQ(a, tracker.join(a, a));
+  TaintSet ab = tracker.join(a, b);
+  EXPECT_EQ(ab, tracker.join(b, a));
+  EXPECT_EQ(tracker.join(ab, c), tracker.join(a, tracker.join(c, b)));
+  EXPECT_EQ(ab, tracker.join(ab, a));
+}
+
+TEST(TaintTrackerTest, Reach) {
+  TaintTracker tracker;
+  const std::string file = "a.c";
+  InstructionInfo info(0, file, 3, 0, 42);
+  KInstruction ki;
+  ki.info = &info;
+  ki.operands = nullptr;
+
+  tracker.reach(&ki, 0);
+  EXPECT_TRUE(tracker.getIndex().getSites().empty());
+
+  TaintSet x2 = tracker.label("x", 2);
+  TaintSet y1 = tracker.label("y", 1);
+  tracker.reach(&ki, tracker.join(x2, y1));
+  tracker.reach(&ki, tracker.label("x", 3));
+  const DependencyIndex &index = tracker.getIndex();
+  ASSERT_EQ(1u, index.getSites().size());
+  const DependencyIndex::Site &site = index.getSites().at(42);
+  EXPECT_EQ("a.c", site.file);
+  EXPECT_EQ(3u, site.line);
+  std::vector<DependencyIndex::Range> expected = {{0, 2, 4}, {1, 1, 2}};
+  EXPECT_EQ(expected, site.getRanges());
+}